@@ -1,5 +1,6 @@
 #include "CSVStreamer.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <iostream>
@@ -34,8 +35,20 @@ CSVStreamer::~CSVStreamer()
 
 bool CSVStreamer::prepareFile(const std::string& directory)
 {
-	filePath = directory + logFileName;
-	csvFile.open(filePath, std::ios::out);
+	if (format == Format::STDOUT)
+		return true;
+
+	if (format == Format::BINARY)
+	{
+		filePath = directory + binaryLogFileName;
+		csvFile.open(filePath, std::ios::out | std::ios::binary);
+	}
+	else
+	{
+		filePath = directory + logFileName;
+		csvFile.open(filePath, std::ios::out);
+	}
+
 	if (!csvFile.is_open())
 	{
 		logger->error("Failed to open file: {}", filePath);
@@ -44,6 +57,16 @@ bool CSVStreamer::prepareFile(const std::string& directory)
 	return true;
 }
 
+void CSVStreamer::setFormat(Format newFormat)
+{
+	format = newFormat;
+}
+
+CSVStreamer::Format CSVStreamer::getFormat() const
+{
+	return format;
+}
+
 void CSVStreamer::createHeader(const std::vector<std::string>& headerNames)
 {
 	this->headerNames = headerNames;
@@ -59,13 +82,56 @@ void CSVStreamer::createHeader(const std::vector<std::string>& headerNames)
 
 void CSVStreamer::writeLine(double time, std::unordered_map<std::string, double>& valuesMap)
 {
-	std::string line = std::to_string(time) + ",";
-	for (const auto& name : headerNames)
+	std::string line;
+
+	if (format == Format::BINARY)
+	{
+		line.resize((headerNames.size() + 1) * sizeof(double));
+		std::memcpy(line.data(), &time, sizeof(double));
+		for (size_t i = 0; i < headerNames.size(); i++)
+		{
+			double value = valuesMap[headerNames[i]];
+			std::memcpy(line.data() + (i + 1) * sizeof(double), &value, sizeof(double));
+		}
+	}
+	else
+	{
+		line = std::to_string(time) + ",";
+		for (const auto& name : headerNames)
+		{
+			line += std::to_string(valuesMap[name]) + ",";
+		}
+		line.back() = '\n';
+	}
+
+	pushLine(line);
+}
+
+void CSVStreamer::writeLine(double time, const std::vector<double>& values)
+{
+	std::string line;
+
+	if (format == Format::BINARY)
 	{
-		line += std::to_string(valuesMap[name]) + ",";
+		line.resize((values.size() + 1) * sizeof(double));
+		std::memcpy(line.data(), &time, sizeof(double));
+		std::memcpy(line.data() + sizeof(double), values.data(), values.size() * sizeof(double));
 	}
-	line.back() = '\n';
+	else
+	{
+		line = std::to_string(time) + ",";
+		for (double value : values)
+		{
+			line += std::to_string(value) + ",";
+		}
+		line.back() = '\n';
+	}
+
+	pushLine(line);
+}
 
+void CSVStreamer::pushLine(std::string& line)
+{
 	currentBuffer->appendLine(line);
 
 	if (currentBuffer->isFull())
@@ -86,26 +152,43 @@ void CSVStreamer::exchangeBuffers()
 	currentBuffer->index = 0;
 }
 
+std::ostream& CSVStreamer::getOutput()
+{
+	if (format == Format::STDOUT)
+		return std::cout;
+	return csvFile;
+}
+
 void CSVStreamer::writeFile()
 {
-	if (!csvFile.is_open())
+	if (format != Format::STDOUT && !csvFile.is_open())
 	{
 		logger->error("CSV file is not open!");
 		return;
 	}
 
+	std::ostream& output = getOutput();
 	for (size_t i = 0; i < processingBuffer->index; i++)
 	{
-		csvFile << processingBuffer->buffer[i];
+		output << processingBuffer->buffer[i];
 	}
+	output.flush();
 }
 
 void CSVStreamer::finishLogging()
 {
+	if (saveTask.valid())
+		saveTask.wait();
+
 	if (csvFile.is_open())
 	{
 		exchangeBuffers();
 		writeFile();
 		csvFile.close();
 	}
+	else if (format == Format::STDOUT && currentBuffer->index > 0)
+	{
+		exchangeBuffers();
+		writeFile();
+	}
 }
\ No newline at end of file
@@ -12,6 +12,14 @@
 class CSVStreamer
 {
    public:
+	/* BINARY files start with the csv header line followed by rows of native endian doubles, time first */
+	enum class Format : uint8_t
+	{
+		CSV = 0,
+		BINARY = 1,
+		STDOUT = 2,
+	};
+
 	struct Buffer
 	{
 		bool appendLine(std::string& line);
@@ -25,11 +33,16 @@ class CSVStreamer
 	CSVStreamer(spdlog::logger* logger);
 	~CSVStreamer();
 
-	/// @brief Creates file in given directory with a fixed name
+	/// @brief Creates file in given directory with a fixed name, for the STDOUT format no file is created
 	/// @param directory directory string
 	/// @return
 	bool prepareFile(const std::string& directory);
 
+	/// @brief selects the output format of the next prepareFile call
+	/// @param newFormat
+	void setFormat(Format newFormat);
+	Format getFormat() const;
+
 	/// @brief create csv file header from given argument, first column - time - is added internally
 	/// @param headerNames table headers
 	void createHeader(const std::vector<std::string>& headerNames);
@@ -39,6 +52,11 @@ class CSVStreamer
 	/// @param valuesMap
 	void writeLine(double time, std::unordered_map<std::string, double>& valuesMap);
 
+	/// @brief writes single line to internal buffer
+	/// @param time
+	/// @param values values in the order of the header names
+	void writeLine(double time, const std::vector<double>& values);
+
 	/// @brief exchanges the buffer that is being processed with the one that's being written to
 	void exchangeBuffers();
 
@@ -49,9 +67,14 @@ class CSVStreamer
 	void finishLogging();
 
    private:
+	std::ostream& getOutput();
+	void pushLine(std::string& line);
+
 	const char* logFileName = "/logfile.csv";
+	const char* binaryLogFileName = "/logfile.bin";
 
 	spdlog::logger* logger;
+	Format format = Format::CSV;
 	std::future<void> saveTask{};
 	std::string filePath;
 	std::ofstream csvFile;
@@ -79,6 +79,9 @@ void ConfigHandler::loadVariables()
 		if (shouldUpdateFromElf.empty())
 			shouldUpdateFromElf = "true";
 		newVar->setShouldUpdateFromElf(shouldUpdateFromElf == "true" ? true : false);
+
+		if (!newVar->setPointerOffsetsFromString(ini->get(varFieldFromID(varId)).get("pointer_offsets")))
+			logger->warn("Incorrect pointer offsets of variable {}", newVar->getName());
 		varId++;
 
 		if (newVar->getAddress() % 4 != 0)
@@ -128,12 +131,26 @@ void ConfigHandler::loadPlots()
 			plotHandler->addPlot(plotName);
 			auto plot = plotHandler->getPlot(plotName);
 			plot->setType(type);
+			plot->setSampleFrequency(atoi(ini->get(sectionName).get("sample_frequency_hz").c_str()));
+			if (type == Plot::Type::CURVE)
+			{
+				plot->setDecimationFactor(atoi(ini->get(sectionName).get("decimation_factor").c_str()));
+				if (!ini->get(sectionName).get("decimation_points").empty())
+					plot->setDecimatedMaxPoints(atoi(ini->get(sectionName).get("decimation_points").c_str()));
+				plot->setDecimationMode(static_cast<Plot::DecimationMode>(atoi(ini->get(sectionName).get("decimation_mode").c_str())));
+			}
 			if (type == Plot::Type::XY)
 			{
 				std::string xAxisVariable = ini->get(sectionName).get("x_axis_variable");
 				if (variableHandler->contains(xAxisVariable))
 					plot->setXAxisVariable(variableHandler->getVariable(xAxisVariable).get());
 			}
+			else if (type == Plot::Type::ARRAY)
+			{
+				plot->setArrayLength(atoi(ini->get(sectionName).get("array_length").c_str()));
+				plot->setArrayPersistence(atoi(ini->get(sectionName).get("array_persistence").c_str()));
+				plot->setArrayAveraging(atoi(ini->get(sectionName).get("array_averaging").c_str()));
+			}
 
 			logger->info("Adding plot: {}", plotName);
 			uint32_t seriesNumber = 0;
@@ -243,6 +260,49 @@ void ConfigHandler::loadPlotGroups()
 	}
 }
 
+void ConfigHandler::loadWatches(WatchEngine& engine, const std::string& prefix)
+{
+	std::vector<WatchEngine::Watch> watches;
+
+	for (uint32_t watchNumber = 0; ini->has(prefix + "watch" + std::to_string(watchNumber)); watchNumber++)
+	{
+		auto section = ini->get(prefix + "watch" + std::to_string(watchNumber));
+		WatchEngine::Watch watch{};
+		watch.name = section.get("name");
+		watch.variableName = section.get("variable");
+		watch.condition = static_cast<WatchEngine::Condition>(atoi(section.get("condition").c_str()));
+		watch.threshold = atof(section.get("threshold").c_str());
+		watch.hysteresis = atof(section.get("hysteresis").c_str());
+		if (!section.get("mask").empty())
+			watch.mask = std::strtoul(section.get("mask").c_str(), nullptr, 10);
+		watch.debounceSamples = std::max(1, atoi(section.get("debounce").c_str()));
+		watch.stopAcquisition = section.get("stop") == "true";
+		watch.enabled = section.get("enabled") != "false";
+		logger->info("Adding watch: {}", watch.name);
+		watches.push_back(watch);
+	}
+
+	engine.setWatches(watches);
+}
+
+void ConfigHandler::saveWatches(mINI::INIStructure& configIni, const WatchEngine& engine, const std::string& prefix)
+{
+	uint32_t watchId = 0;
+	for (auto& watch : engine.getWatches())
+	{
+		const std::string sectionName = prefix + "watch" + std::to_string(watchId++);
+		(configIni)[sectionName]["name"] = watch.name;
+		(configIni)[sectionName]["variable"] = watch.variableName;
+		(configIni)[sectionName]["condition"] = std::to_string(static_cast<uint8_t>(watch.condition));
+		(configIni)[sectionName]["threshold"] = std::to_string(watch.threshold);
+		(configIni)[sectionName]["hysteresis"] = std::to_string(watch.hysteresis);
+		(configIni)[sectionName]["mask"] = std::to_string(watch.mask);
+		(configIni)[sectionName]["debounce"] = std::to_string(watch.debounceSamples);
+		(configIni)[sectionName]["stop"] = watch.stopAcquisition ? std::string("true") : std::string("false");
+		(configIni)[sectionName]["enabled"] = watch.enabled ? std::string("true") : std::string("false");
+	}
+}
+
 bool ConfigHandler::readConfigFile(std::string& elfPath)
 {
 	ViewerDataHandler::Settings viewerSettings{};
@@ -283,6 +343,45 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	viewerSettings.logFilePath = ini->get("settings").get("log_directory");
 	viewerSettings.gdbCommand = ini->get("settings").get("gdb_command");
 
+	getValue("settings", "target_timestamps", viewerSettings.useTargetTimestamps);
+	getValue("settings", "core_frequency", viewerSettings.coreFrequency);
+	getValue("settings", "trigger_type", viewerSettings.trigger.type);
+	viewerSettings.trigger.variableName = ini->get("settings").get("trigger_variable");
+	getValue("settings", "trigger_level", viewerSettings.trigger.level);
+	getValue("settings", "trigger_pre_points", viewerSettings.trigger.preTriggerPoints);
+	getValue("settings", "trigger_post_points", viewerSettings.trigger.postTriggerPoints);
+	getValue("settings", "trigger_rearm", viewerSettings.trigger.rearm);
+
+	getValue("settings", "pointer_refresh_frequency_hz", viewerSettings.pointerRefreshFrequencyHz);
+	getValue("settings", "burst_mode", viewerSettings.burstMode);
+	getValue("settings", "burst_samples", viewerSettings.burstSamples);
+	getValue("settings", "burst_time_s", viewerSettings.burstTimeS);
+	getValue("settings", "stimulus_type", viewerSettings.stimulus.type);
+	viewerSettings.stimulus.variableName = ini->get("settings").get("stimulus_variable");
+	getValue("settings", "stimulus_write_frequency_hz", viewerSettings.stimulus.writeFrequencyHz);
+	getValue("settings", "stimulus_offset", viewerSettings.stimulus.offset);
+	getValue("settings", "stimulus_amplitude", viewerSettings.stimulus.amplitude);
+	getValue("settings", "stimulus_time", viewerSettings.stimulus.time);
+	getValue("settings", "stimulus_frequency_hz", viewerSettings.stimulus.frequencyHz);
+	getValue("settings", "stimulus_end_frequency_hz", viewerSettings.stimulus.endFrequencyHz);
+	viewerSettings.stimulus.profilePath = ini->get("settings").get("stimulus_profile");
+	getValue("settings", "rtt_enabled", viewerSettings.rtt.enabled);
+	getValue("settings", "rtt_up_buffer", viewerSettings.rtt.upBuffer);
+	getValue("settings", "rtt_read_frequency_hz", viewerSettings.rtt.readFrequencyHz);
+	getValue("settings", "rtt_ram_size", viewerSettings.rtt.ramSize);
+	viewerSettings.rtt.channelVariables = ini->get("settings").get("rtt_channel_variables");
+	getValue("settings", "thread_policy", viewerSettings.threadPriority.policy);
+	getValue("settings", "thread_priority", viewerSettings.threadPriority.priority);
+	getValue("settings", "thread_cpu_core", viewerSettings.threadPriority.cpuCore);
+
+	/* masks use the whole 32 bit range */
+	if (!ini->get("settings").get("trigger_mask").empty())
+		viewerSettings.trigger.mask = std::strtoul(ini->get("settings").get("trigger_mask").c_str(), nullptr, 10);
+	if (!ini->get("settings").get("trigger_value").empty())
+		viewerSettings.trigger.value = std::strtoul(ini->get("settings").get("trigger_value").c_str(), nullptr, 10);
+	if (!ini->get("settings").get("rtt_ram_start").empty())
+		viewerSettings.rtt.ramStart = std::strtoul(ini->get("settings").get("rtt_ram_start").c_str(), nullptr, 10);
+
 	if (viewerSettings.gdbCommand.empty())
 		viewerSettings.gdbCommand = "gdb";
 
@@ -299,6 +398,9 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	traceProbeSettings.serialNumber = ini->get("trace_settings").get("probe_SN");
 	getValue("trace_settings", "should_log", traceSettings.shouldLog);
 	traceSettings.logFilePath = ini->get("trace_settings").get("log_directory");
+	getValue("trace_settings", "thread_policy", traceSettings.threadPriority.policy);
+	getValue("trace_settings", "thread_priority", traceSettings.threadPriority.priority);
+	getValue("trace_settings", "thread_cpu_core", traceSettings.threadPriority.cpuCore);
 
 	/* TODO magic numbers (lots of them)! */
 	if (traceSettings.timeout == 0)
@@ -329,6 +431,8 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	loadPlots();
 	loadTracePlots();
 	loadPlotGroups();
+	loadWatches(viewerDataHandler->getWatchEngine(), "");
+	loadWatches(traceDataHandler->getWatchEngine(), "trace_");
 
 	viewerDataHandler->setSettings(viewerSettings);
 	viewerDataHandler->setProbeSettings(debugProbeSettings);
@@ -395,6 +499,38 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 	(configIni)["settings"]["should_log"] = viewerSettings.shouldLog ? std::string("true") : std::string("false");
 	(configIni)["settings"]["log_directory"] = viewerSettings.logFilePath;
 	(configIni)["settings"]["gdb_command"] = viewerSettings.gdbCommand;
+	(configIni)["settings"]["target_timestamps"] = viewerSettings.useTargetTimestamps ? std::string("true") : std::string("false");
+	(configIni)["settings"]["core_frequency"] = std::to_string(viewerSettings.coreFrequency);
+	(configIni)["settings"]["trigger_type"] = std::to_string(static_cast<uint8_t>(viewerSettings.trigger.type));
+	(configIni)["settings"]["trigger_variable"] = viewerSettings.trigger.variableName;
+	(configIni)["settings"]["trigger_level"] = std::to_string(viewerSettings.trigger.level);
+	(configIni)["settings"]["trigger_mask"] = std::to_string(viewerSettings.trigger.mask);
+	(configIni)["settings"]["trigger_value"] = std::to_string(viewerSettings.trigger.value);
+	(configIni)["settings"]["trigger_pre_points"] = std::to_string(viewerSettings.trigger.preTriggerPoints);
+	(configIni)["settings"]["trigger_post_points"] = std::to_string(viewerSettings.trigger.postTriggerPoints);
+	(configIni)["settings"]["trigger_rearm"] = viewerSettings.trigger.rearm ? std::string("true") : std::string("false");
+	(configIni)["settings"]["pointer_refresh_frequency_hz"] = std::to_string(viewerSettings.pointerRefreshFrequencyHz);
+	(configIni)["settings"]["burst_mode"] = viewerSettings.burstMode ? std::string("true") : std::string("false");
+	(configIni)["settings"]["burst_samples"] = std::to_string(viewerSettings.burstSamples);
+	(configIni)["settings"]["burst_time_s"] = std::to_string(viewerSettings.burstTimeS);
+	(configIni)["settings"]["stimulus_type"] = std::to_string(static_cast<uint8_t>(viewerSettings.stimulus.type));
+	(configIni)["settings"]["stimulus_variable"] = viewerSettings.stimulus.variableName;
+	(configIni)["settings"]["stimulus_write_frequency_hz"] = std::to_string(viewerSettings.stimulus.writeFrequencyHz);
+	(configIni)["settings"]["stimulus_offset"] = std::to_string(viewerSettings.stimulus.offset);
+	(configIni)["settings"]["stimulus_amplitude"] = std::to_string(viewerSettings.stimulus.amplitude);
+	(configIni)["settings"]["stimulus_time"] = std::to_string(viewerSettings.stimulus.time);
+	(configIni)["settings"]["stimulus_frequency_hz"] = std::to_string(viewerSettings.stimulus.frequencyHz);
+	(configIni)["settings"]["stimulus_end_frequency_hz"] = std::to_string(viewerSettings.stimulus.endFrequencyHz);
+	(configIni)["settings"]["stimulus_profile"] = viewerSettings.stimulus.profilePath;
+	(configIni)["settings"]["rtt_enabled"] = viewerSettings.rtt.enabled ? std::string("true") : std::string("false");
+	(configIni)["settings"]["rtt_up_buffer"] = std::to_string(viewerSettings.rtt.upBuffer);
+	(configIni)["settings"]["rtt_read_frequency_hz"] = std::to_string(viewerSettings.rtt.readFrequencyHz);
+	(configIni)["settings"]["rtt_ram_start"] = std::to_string(viewerSettings.rtt.ramStart);
+	(configIni)["settings"]["rtt_ram_size"] = std::to_string(viewerSettings.rtt.ramSize);
+	(configIni)["settings"]["rtt_channel_variables"] = viewerSettings.rtt.channelVariables;
+	(configIni)["settings"]["thread_policy"] = std::to_string(static_cast<uint8_t>(viewerSettings.threadPriority.policy));
+	(configIni)["settings"]["thread_priority"] = std::to_string(viewerSettings.threadPriority.priority);
+	(configIni)["settings"]["thread_cpu_core"] = std::to_string(viewerSettings.threadPriority.cpuCore);
 
 	(configIni)["trace_settings"]["core_frequency"] = std::to_string(traceSettings.coreFrequency);
 	(configIni)["trace_settings"]["trace_prescaler"] = std::to_string(traceSettings.tracePrescaler);
@@ -409,6 +545,9 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 	(configIni)["trace_settings"]["probe_SN"] = traceProbeSettings.serialNumber;
 	(configIni)["trace_settings"]["should_log"] = traceSettings.shouldLog ? std::string("true") : std::string("false");
 	(configIni)["trace_settings"]["log_directory"] = traceSettings.logFilePath;
+	(configIni)["trace_settings"]["thread_policy"] = std::to_string(static_cast<uint8_t>(traceSettings.threadPriority.policy));
+	(configIni)["trace_settings"]["thread_priority"] = std::to_string(traceSettings.threadPriority.priority);
+	(configIni)["trace_settings"]["thread_cpu_core"] = std::to_string(traceSettings.threadPriority.cpuCore);
 
 	uint32_t varId = 0;
 	for (std::shared_ptr<Variable> var : *variableHandler)
@@ -421,6 +560,8 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 		(configIni)[varFieldFromID(varId)]["should_update_from_elf"] = var->getShouldUpdateFromElf() ? "true" : "false";
 		(configIni)[varFieldFromID(varId)]["shift"] = std::to_string(var->getShift());
 		(configIni)[varFieldFromID(varId)]["mask"] = std::to_string(var->getMask());
+		if (var->isPointerChain())
+			(configIni)[varFieldFromID(varId)]["pointer_offsets"] = var->getPointerOffsetsString();
 		(configIni)[varFieldFromID(varId)]["high_level_type"] = std::to_string(static_cast<uint8_t>(var->getHighLevelType()));
 
 		if (var->isFractional())
@@ -439,9 +580,23 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 	{
 		(configIni)[plotFieldFromID(plotId)]["name"] = plt->getName();
 		(configIni)[plotFieldFromID(plotId)]["type"] = std::to_string(static_cast<uint8_t>(plt->getType()));
+		(configIni)[plotFieldFromID(plotId)]["sample_frequency_hz"] = std::to_string(plt->getSampleFrequency());
+
+		if (plt->getType() == Plot::Type::CURVE && plt->getDecimationFactor() > 0)
+		{
+			(configIni)[plotFieldFromID(plotId)]["decimation_factor"] = std::to_string(plt->getDecimationFactor());
+			(configIni)[plotFieldFromID(plotId)]["decimation_points"] = std::to_string(plt->getDecimatedMaxPoints());
+			(configIni)[plotFieldFromID(plotId)]["decimation_mode"] = std::to_string(static_cast<uint8_t>(plt->getDecimationMode()));
+		}
 
 		if (plt->getType() == Plot::Type::XY)
 			(configIni)[plotFieldFromID(plotId)]["x_axis_variable"] = plt->getXAxisVariable() != nullptr ? plt->getXAxisVariable()->getName() : "";
+		else if (plt->getType() == Plot::Type::ARRAY)
+		{
+			(configIni)[plotFieldFromID(plotId)]["array_length"] = std::to_string(plt->getArrayLength());
+			(configIni)[plotFieldFromID(plotId)]["array_persistence"] = std::to_string(plt->getArrayPersistence());
+			(configIni)[plotFieldFromID(plotId)]["array_averaging"] = std::to_string(plt->getArrayAveraging());
+		}
 
 		uint32_t serId = 0;
 
@@ -498,6 +653,9 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 		plotId++;
 	}
 
+	saveWatches(configIni, viewerDataHandler->getWatchEngine(), "");
+	saveWatches(configIni, traceDataHandler->getWatchEngine(), "trace_");
+
 	return configIni;
 }
 
@@ -57,6 +57,8 @@ class ConfigHandler
 	void loadPlots();
 	void loadTracePlots();
 	void loadPlotGroups();
+	void loadWatches(WatchEngine& engine, const std::string& prefix);
+	void saveWatches(mINI::INIStructure& configIni, const WatchEngine& engine, const std::string& prefix);
 
 	mINI::INIStructure prepareSaveConfigFile(const std::string& elfPath);
 
@@ -0,0 +1,63 @@
+#ifndef _CYCLECOUNTER_HPP
+#define _CYCLECOUNTER_HPP
+
+#include <cstdint>
+
+/* Converts raw DWT CYCCNT readouts to seconds. The 32-bit counter rolls over every 2^32 core
+cycles (~26.8s @ 160MHz) so it has to be sampled at least once per rollover period to be unwrapped correctly. */
+class CycleCounter
+{
+   public:
+	static constexpr uint32_t demcrAddress = 0xE000EDFC;
+	static constexpr uint32_t demcrTrcena = (1 << 24);
+	static constexpr uint32_t dwtCtrlAddress = 0xE0001000;
+	static constexpr uint32_t dwtCtrlCyccntena = (1 << 0);
+	static constexpr uint32_t dwtCyccntAddress = 0xE0001004;
+
+	explicit CycleCounter(uint32_t coreFrequencyHz = 160000000) : coreFrequencyHz(coreFrequencyHz) {}
+
+	void reset()
+	{
+		isFirstSample = true;
+		lastValue = 0;
+		totalCycles = 0;
+	}
+
+	void setCoreFrequency(uint32_t frequencyHz)
+	{
+		coreFrequencyHz = frequencyHz;
+	}
+
+	uint32_t getCoreFrequency() const
+	{
+		return coreFrequencyHz;
+	}
+
+	/* returns the time in seconds that elapsed since the first sample after reset */
+	double update(uint32_t cyccnt)
+	{
+		if (isFirstSample)
+		{
+			isFirstSample = false;
+			lastValue = cyccnt;
+			return 0.0;
+		}
+
+		/* unsigned subtraction handles a single rollover */
+		totalCycles += static_cast<uint32_t>(cyccnt - lastValue);
+		lastValue = cyccnt;
+
+		if (coreFrequencyHz == 0)
+			return 0.0;
+
+		return static_cast<double>(totalCycles) / coreFrequencyHz;
+	}
+
+   private:
+	uint32_t coreFrequencyHz;
+	bool isFirstSample = true;
+	uint32_t lastValue = 0;
+	uint64_t totalCycles = 0;
+};
+
+#endif
@@ -26,6 +26,8 @@ class DataHandlerBase
 	virtual ~DataHandlerBase() = default;
 
 	virtual std::string getLastReaderError() const = 0;
+	/* closes the probe session kept open between acquisitions, ignored while running */
+	virtual void disconnectProbe() = 0;
 
 	void setState(State state)
 	{
@@ -35,6 +37,11 @@ class DataHandlerBase
 		viewerState = state;
 		stateChangeOrdered = true;
 	}
+	void setLogFormat(CSVStreamer::Format format)
+	{
+		csvStreamer->setFormat(format);
+	}
+
 	State getState() const
 	{
 		/* TODO possible deadlock */
@@ -57,6 +57,17 @@ void TraceDataHandler::setDebugProbe(std::shared_ptr<ITraceProbe> probe)
 	traceReader->changeDevice(probe);
 }
 
+ProbeStatistics* TraceDataHandler::getProbeStatistics() const
+{
+	return traceReader->getProbeStatistics();
+}
+
+void TraceDataHandler::disconnectProbe()
+{
+	if (viewerState == State::STOP && !stateChangeOrdered)
+		traceReader->disconnect();
+}
+
 ITraceProbe::TraceProbeSettings TraceDataHandler::getProbeSettings() const
 {
 	return probeSettings;
@@ -78,6 +89,7 @@ void TraceDataHandler::setSettings(const Settings& settings)
 	traceReader->setTraceFrequency(settings.tracePrescaler);
 	traceReader->setTraceShouldReset(settings.shouldReset);
 	traceReader->setTraceTimeout(settings.timeout);
+	traceReader->setThreadPriority(settings.threadPriority);
 	tracePlotHandler->setMaxPoints(settings.maxPoints);
 	this->settings = settings;
 }
@@ -163,6 +175,7 @@ void TraceDataHandler::dataHandler()
 				}
 
 				csvEntry[ser->var->getName()] = newPoint;
+				watchValues[i] = newPoint;
 
 				/* thread-safe part */
 				std::lock_guard<std::mutex> lock(*mtx);
@@ -174,6 +187,13 @@ void TraceDataHandler::dataHandler()
 			if (settings.shouldLog)
 				csvStreamer->writeLine(time, csvEntry);
 
+			if (!watchEngine.isEmpty() && watchEngine.process(time, watchValues))
+			{
+				logger->info("Watch hit. Stopping.");
+				viewerState = State::STOP;
+				stateChangeOrdered = true;
+			}
+
 			if (traceTriggered && cnt++ >= (settings.maxPoints * 0.9))
 			{
 				logger->info("After-trigger trace collcted. Stopping.");
@@ -204,6 +224,10 @@ void TraceDataHandler::dataHandler()
 		{
 			if (viewerState == State::RUN)
 			{
+				std::string threadErrorMsg;
+				if (!ThreadPriority::apply(settings.threadPriority, threadErrorMsg))
+					logger->warn("Trace data handler thread: {}", threadErrorMsg);
+
 				std::array<bool, 32> activeChannels{};
 
 				size_t i = 0;
@@ -215,6 +239,7 @@ void TraceDataHandler::dataHandler()
 				lastErrorMsg = "";
 
 				prepareCSVFile();
+				compileWatches();
 
 				if (traceReader->startAcqusition(probeSettings, activeChannels))
 					time = 0;
@@ -253,6 +278,23 @@ void TraceDataHandler::prepareCSVFile()
 	csvStreamer->createHeader(headerNames);
 }
 
+void TraceDataHandler::compileWatches()
+{
+	std::fill(watchValues.begin(), watchValues.end(), 0.0);
+
+	watchEngine.compile([this](const std::string& variableName) -> int32_t
+						{
+		int32_t i = 0;
+		for (auto plot : *tracePlotHandler)
+		{
+			if (plot->getName() == variableName || plot->getAlias() == variableName)
+				return plot->getVisibility() ? i : -1;
+			i++;
+		}
+		logger->warn("Watch channel {} not found, watch skipped!", variableName);
+		return -1; });
+}
+
 void TraceDataHandler::initPlots()
 {
 	const uint32_t colors[] = {4294967040, 4294960666, 4294954035, 4294947661, 4294941030, 4294934656, 4294928025, 4294921651, 4294915020, 4294908646, 4294902015};
@@ -9,7 +9,9 @@
 #include "DataHandlerBase.hpp"
 #include "Plot.hpp"
 #include "StlinkTraceProbe.hpp"
+#include "ThreadPriority.hpp"
 #include "TraceReader.hpp"
+#include "WatchEngine.hpp"
 #include "spdlog/spdlog.h"
 
 class TraceDataHandler : public DataHandlerBase
@@ -27,6 +29,8 @@ class TraceDataHandler : public DataHandlerBase
 		uint32_t timeout = 2;
 		bool shouldLog = false;
 		std::string logFilePath = "";
+		/* applied to both the trace reader and the trace data handler threads */
+		ThreadPriority::Settings threadPriority{};
 	} Settings;
 
 	TraceDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger);
@@ -36,17 +40,23 @@ class TraceDataHandler : public DataHandlerBase
 	std::vector<double> getErrorTimestamps();
 	std::vector<double> getDelayed3Timestamps();
 	std::string getLastReaderError() const;
+	void disconnectProbe() override;
 
 	void setTriggerChannel(int32_t triggerChannel);
 	int32_t getTriggerChannel() const;
 
 	void setDebugProbe(std::shared_ptr<ITraceProbe> probe);
+	/* nullptr until a probe is set */
+	ProbeStatistics* getProbeStatistics() const;
 	ITraceProbe::TraceProbeSettings getProbeSettings() const;
 	void setProbeSettings(const ITraceProbe::TraceProbeSettings& settings);
 
 	Settings getSettings() const;
 	void setSettings(const Settings& settings);
 
+	/* watch variables are channel names or aliases, watches are compiled on every start */
+	WatchEngine& getWatchEngine() { return watchEngine; }
+
 	/* TODO refactor so these are not here: (ideally using traceVeriableHandler)*/
 	double getDoubleValue(const Plot& plot, uint32_t value);
 	void initPlots();
@@ -55,6 +65,7 @@ class TraceDataHandler : public DataHandlerBase
    private:
 	void dataHandler();
 	void prepareCSVFile();
+	void compileWatches();
 
    private:
 	class MarkerTimestamps
@@ -106,4 +117,7 @@ class TraceDataHandler : public DataHandlerBase
 	static constexpr size_t maxAllowedViewportErrors = 100;
 
 	std::unordered_map<std::string, double> csvEntry;
+
+	WatchEngine watchEngine{};
+	std::vector<double> watchValues = std::vector<double>(channels, 0.0);
 };
@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 
 #include "JlinkDebugProbe.hpp"
@@ -16,13 +19,71 @@ ViewerDataHandler::~ViewerDataHandler()
 {
 	if (dataHandle.joinable())
 		dataHandle.join();
+	stopPipeline();
 }
 
-bool ViewerDataHandler::writeSeriesValue(Variable& var, double value)
+bool ViewerDataHandler::writeSeriesValue(Variable& var, double value, std::function<void(bool)> onComplete)
 {
-	std::lock_guard<std::mutex> lock(*mtx);
-	uint32_t rawValue = var.getRawFromDouble(value);
-	return debugProbe->writeMemory(var.getAddress(), (uint8_t*)&rawValue, var.getSize());
+	return writeQueue.push({var.getSampleAddress(), var.getRawFromDouble(value), var.getSize(), onComplete});
+}
+
+void ViewerDataHandler::processWriteRequests()
+{
+	if (writeQueue.empty())
+		return;
+
+	/* later writes to the same bytes override the earlier ones */
+	std::map<uint32_t, uint8_t> bytes;
+	std::vector<WriteRequest> requests;
+
+	while (auto request = writeQueue.pop())
+	{
+		for (uint32_t i = 0; i < request->size; i++)
+			bytes[request->address + i] = reinterpret_cast<uint8_t*>(&request->value)[i];
+		requests.push_back(std::move(request.value()));
+	}
+
+	/* adjacent bytes are merged into a single probe transaction */
+	std::map<uint32_t, bool> transactionResults;
+	std::vector<uint8_t> buffer;
+	buffer.reserve(maxWriteTransactionSize);
+
+	for (auto it = bytes.begin(); it != bytes.end();)
+	{
+		uint32_t startAddress = it->first;
+		buffer.clear();
+
+		while (it != bytes.end() && it->first == startAddress + buffer.size() && buffer.size() < maxWriteTransactionSize)
+		{
+			buffer.push_back(it->second);
+			it++;
+		}
+
+		bool result = debugProbe->writeMemory(startAddress, buffer.data(), buffer.size());
+
+		for (uint32_t i = 0; i < buffer.size(); i++)
+			transactionResults[startAddress + i] = result;
+	}
+
+	logger->debug("{} write request(s) merged into {} byte(s)", requests.size(), bytes.size());
+
+	for (auto& request : requests)
+	{
+		if (request.onComplete == nullptr)
+			continue;
+
+		bool result = true;
+		for (uint32_t i = 0; i < request.size; i++)
+			result = result && transactionResults[request.address + i];
+		request.onComplete(result);
+	}
+}
+
+void ViewerDataHandler::cancelWriteRequests()
+{
+	while (auto request = writeQueue.pop())
+		if (request->onComplete != nullptr)
+			request->onComplete(false);
 }
 
 std::string ViewerDataHandler::getLastReaderError() const
@@ -32,9 +93,23 @@ std::string ViewerDataHandler::getLastReaderError() const
 
 void ViewerDataHandler::setDebugProbe(std::shared_ptr<IDebugProbe> probe)
 {
+	/* the session of the previous probe would keep its device claimed */
+	if (debugProbe != nullptr && debugProbe != probe)
+		disconnectProbe();
 	debugProbe = probe;
 }
 
+ProbeStatistics* ViewerDataHandler::getProbeStatistics() const
+{
+	return debugProbe == nullptr ? nullptr : &debugProbe->getStatistics();
+}
+
+void ViewerDataHandler::disconnectProbe()
+{
+	if (viewerState == State::STOP && !stateChangeOrdered)
+		debugProbe->disconnect();
+}
+
 IDebugProbe::DebugProbeSettings ViewerDataHandler::getProbeSettings() const
 {
 	return probeSettings;
@@ -50,39 +125,689 @@ ViewerDataHandler::Settings ViewerDataHandler::getSettings() const
 	return settings;
 }
 
-void ViewerDataHandler::setSettings(const Settings& newSettings)
+void ViewerDataHandler::setSettings(const Settings& newSettings)
+{
+	settings = newSettings;
+	plotHandler->setMaxPoints(settings.maxPoints);
+}
+
+ViewerDataHandler::StimulusStatistics ViewerDataHandler::getStimulusStatistics() const
+{
+	std::lock_guard<std::mutex> lock(stimulusMtx);
+	return stimulusStatistics;
+}
+
+ViewerDataHandler::RttStatistics ViewerDataHandler::getRttStatistics() const
+{
+	std::lock_guard<std::mutex> lock(rttMtx);
+	return rttStatistics;
+}
+
+void ViewerDataHandler::captureBurst(std::chrono::time_point<std::chrono::steady_clock> start)
+{
+	const size_t maxSamples = std::min(settings.burstSamples, settings.maxPoints);
+	const size_t entries = samplePlan->sampleList.size();
+
+	if (settings.burstSamples > settings.maxPoints)
+		logger->warn("Burst limited to {} samples by the maximum number of plot points", settings.maxPoints);
+
+	if (!samplePlan->arrayReads.empty())
+		logger->warn("Array plots are not captured in burst mode!");
+
+	/* one row of the whole sample list per sample, filled by a single batch read */
+	std::vector<uint32_t> values(maxSamples * entries, 0);
+	std::vector<double> timestamps(maxSamples, 0.0);
+	size_t samples = 0;
+
+	logger->info("Burst capture of {} samples started", maxSamples);
+
+	for (; samples < maxSamples; samples++)
+	{
+		if (entries > 0 && !debugProbe->readMemoryBatch(samplePlan->sampleList, &values[samples * entries]))
+		{
+			logger->error("Read error during burst capture after {} samples", samples);
+			break;
+		}
+
+		timestamps[samples] = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+		if (settings.burstTimeS > 0.0 && timestamps[samples] >= settings.burstTimeS)
+		{
+			samples++;
+			break;
+		}
+	}
+
+	if (samples == 0)
+		return;
+
+	double elapsed = timestamps[samples - 1];
+	if (samples > 1)
+		averageSamplingPeriod = elapsed / (samples - 1);
+
+	logger->info("Burst capture finished: {} samples in {:.3f}s ({:.1f} Hz)", samples, elapsed, getAverageSamplingFrequency());
+
+	/* the processing stage is idle in burst mode, the capture is evaluated here with the plot lock taken once for all samples,
+	   the trigger, the watches and the logging stage apply as in the continuous mode */
+	processingPlan = samplePlan;
+	isBurstReplay = true;
+	std::vector<uint32_t> row(entries);
+	std::vector<uint8_t> isValid(entries, 1);
+
+	std::lock_guard<std::mutex> lock(*mtx);
+	isPlotLockHeld = true;
+	plotHandler->eraseAllPlotData();
+
+	for (size_t sample = 0; sample < samples && !isPipelineHalted; sample++)
+	{
+		row.assign(values.begin() + sample * entries, values.begin() + (sample + 1) * entries);
+
+		/* CYCCNT is the first entry of the sample list */
+		double timestamp = timestamps[sample];
+		if (settings.useTargetTimestamps && entries > 0 && samplePlan->sampleList[0].first == CycleCounter::dwtCyccntAddress)
+			timestamp = cycleCounter.update(row[0]);
+
+		updateVariables(timestamp, row, isValid, allRateClasses);
+	}
+	isPlotLockHeld = false;
+}
+
+void ViewerDataHandler::prepareStimulus()
+{
+	stimulusVariable = nullptr;
+	stimulusTick = 0;
+	{
+		std::lock_guard<std::mutex> lock(stimulusMtx);
+		stimulusStatistics = {};
+	}
+
+	stimulusGenerator.setSettings(settings.stimulus);
+
+	if (!stimulusGenerator.isEnabled())
+		return;
+
+	if (settings.stimulus.writeFrequencyHz == 0)
+	{
+		logger->warn("Stimulus write frequency is zero, stimulus disabled!");
+		return;
+	}
+
+	if (!variableHandler->contains(settings.stimulus.variableName))
+	{
+		logger->warn("Stimulus variable {} not found, stimulus disabled!", settings.stimulus.variableName);
+		return;
+	}
+
+	if (settings.stimulus.type == StimulusGenerator::Type::PROFILE && !stimulusGenerator.loadProfile(settings.stimulus.profilePath))
+	{
+		logger->error("Could not load stimulus profile {}, stimulus disabled!", settings.stimulus.profilePath);
+		return;
+	}
+
+	stimulusVariable = variableHandler->getVariable(settings.stimulus.variableName);
+	logger->info("Stimulus on {} at {} Hz", settings.stimulus.variableName, settings.stimulus.writeFrequencyHz);
+}
+
+void ViewerDataHandler::handleStimulus(double t)
+{
+	if (stimulusVariable == nullptr)
+		return;
+
+	double writePeriod = 1.0 / settings.stimulus.writeFrequencyHz;
+	double scheduled = stimulusTick * writePeriod;
+
+	if (t < scheduled)
+		return;
+
+	/* do not try to catch up - late writes are counted and skipped */
+	uint64_t missed = static_cast<uint64_t>((t - scheduled) / writePeriod);
+	stimulusTick += missed;
+	scheduled = stimulusTick * writePeriod;
+
+	uint32_t rawValue = stimulusVariable->getRawFromDouble(stimulusGenerator.getValue(scheduled));
+	bool result = debugProbe->writeMemory(stimulusVariable->getSampleAddress(), (uint8_t*)&rawValue, stimulusVariable->getSize());
+	stimulusTick++;
+
+	double latenessUs = (t - scheduled) * 1e6;
+
+	std::lock_guard<std::mutex> lock(stimulusMtx);
+	stimulusStatistics.writes++;
+	stimulusStatistics.missedWrites += missed;
+	if (!result)
+		stimulusStatistics.failedWrites++;
+	stimulusStatistics.meanLatenessUs += (latenessUs - stimulusStatistics.meanLatenessUs) / stimulusStatistics.writes;
+	stimulusStatistics.maxLatenessUs = std::max(stimulusStatistics.maxLatenessUs, latenessUs);
+}
+
+void ViewerDataHandler::prepareRtt()
+{
+	rttReader.reset();
+	rttDecoder.reset();
+	rttChannels.clear();
+	rttReadTime = 0.0;
+	{
+		std::lock_guard<std::mutex> lock(rttMtx);
+		rttStatistics = {};
+	}
+
+	if (!settings.rtt.enabled)
+		return;
+
+	if (probeSettings.mode != IDebugProbe::Mode::NORMAL || settings.burstMode)
+	{
+		logger->warn("RTT is read in the continuous normal mode only, RTT disabled!");
+		return;
+	}
+
+	if (settings.rtt.readFrequencyHz == 0)
+	{
+		logger->warn("RTT read frequency is zero, RTT disabled!");
+		return;
+	}
+
+	auto reader = std::make_unique<RttReader>(debugProbe.get(), logger);
+	const uint32_t address = rttControlBlockAddress;
+	const bool isAttached = address != 0 ? reader->attach(address) : reader->find(settings.rtt.ramStart, settings.rtt.ramSize);
+
+	std::lock_guard<std::mutex> lock(rttMtx);
+	if (!isAttached)
+	{
+		rttStatistics.lastErrorMsg = reader->getLastErrorMsg();
+		return;
+	}
+
+	if (settings.rtt.upBuffer >= reader->getUpBuffers().size())
+	{
+		rttStatistics.lastErrorMsg = fmt::format("RTT up-buffer {} not found, the target has {}!", settings.rtt.upBuffer, reader->getUpBuffers().size());
+		logger->warn(rttStatistics.lastErrorMsg);
+		return;
+	}
+
+	for (auto& name : getRttChannelNames())
+	{
+		if (!name.empty() && !variableHandler->contains(name))
+			logger->warn("RTT channel variable {} not found!", name);
+		rttChannels.push_back(variableHandler->contains(name) ? variableHandler->getVariable(name).get() : nullptr);
+	}
+
+	rttStatistics.isAttached = true;
+	rttStatistics.controlBlockAddress = reader->getControlBlockAddress();
+	rttReader = std::move(reader);
+	logger->info("RTT up-buffer {} read at {} Hz", settings.rtt.upBuffer, settings.rtt.readFrequencyHz);
+}
+
+void ViewerDataHandler::readRtt(RawFrame& frame)
+{
+	rttData.clear();
+	if (rttReader->read(settings.rtt.upBuffer, rttData) < 0)
+	{
+		/* a probe error or corrupted offsets, the control block is looked up again on the next start */
+		std::lock_guard<std::mutex> lock(rttMtx);
+		rttStatistics.isAttached = false;
+		rttStatistics.lastErrorMsg = rttReader->getLastErrorMsg();
+		rttReader.reset();
+		return;
+	}
+
+	const size_t records = rttDecoder.decode(rttData, frame.rttRecords);
+
+	std::lock_guard<std::mutex> lock(rttMtx);
+	rttStatistics.bytesRead = rttReader->getBytesRead();
+	rttStatistics.records += records;
+}
+
+void ViewerDataHandler::applyRttRecords(const RawFrame& frame)
+{
+	/* the variables hold the last record of the tick and are plotted with the sampled values */
+	for (auto& record : frame.rttRecords)
+	{
+		if (record.channel >= rttChannels.size() || rttChannels[record.channel] == nullptr)
+			continue;
+
+		Variable* var = rttChannels[record.channel];
+		var->setRawValue(record.value);
+		csvEntry[var->getName()] = var->transformToDouble();
+	}
+}
+
+std::vector<std::string> ViewerDataHandler::getRttChannelNames() const
+{
+	std::vector<std::string> names;
+	if (!settings.rtt.enabled)
+		return names;
+
+	/* empty entries keep the channel numbering */
+	std::istringstream stream(settings.rtt.channelVariables);
+	std::string name;
+	while (std::getline(stream, name, ','))
+	{
+		name.erase(0, name.find_first_not_of(" \t"));
+		name.erase(name.find_last_not_of(" \t") + 1);
+		names.push_back(name);
+	}
+	return names;
+}
+
+void ViewerDataHandler::updateVariables(double timestamp, const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid, uint32_t dueRateClasses)
+{
+	evaluateVariables(values, isValid);
+	processWatches(timestamp);
+
+	if (trigger.isEnabled() && processingPlan->triggerVariable != nullptr)
+		handleTrigger(timestamp, values, isValid, dueRateClasses);
+	else
+		updatePlots(timestamp, dueRateClasses);
+
+	if (settings.shouldLog)
+		logFrame(timestamp);
+}
+
+void ViewerDataHandler::evaluateVariables(const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid)
+{
+	const SamplePlan& plan = *processingPlan;
+
+	/* bases go first in the evaluation order so fractional variables always use the base value of the same sample */
+	for (size_t i = 0; i < plan.evaluationOrder.size(); i++)
+	{
+		const int32_t slot = plan.evaluationSlots[i];
+		if (slot < 0 || static_cast<size_t>(slot) >= values.size() || !isValid[slot])
+			continue;
+
+		Variable* var = plan.evaluationOrder[i];
+		var->setRawValue(values[slot]);
+		csvEntry[var->getName()] = var->transformToDouble();
+	}
+}
+
+void ViewerDataHandler::updatePlots(double timestamp, uint32_t dueRateClasses)
+{
+	for (auto plot : *plotHandler)
+	{
+		/* array plots are updated with whole snapshots in publishArrays */
+		if (plot->getType() == Plot::Type::ARRAY)
+			continue;
+
+		/* plots outside of the sample list are updated with the base rate */
+		auto rateClass = processingPlan->plotRateClass.find(plot.get());
+		if (rateClass != processingPlan->plotRateClass.end() && !(dueRateClasses & (1u << rateClass->second)))
+			continue;
+
+		std::unique_lock<std::mutex> lock(*mtx, std::defer_lock);
+		if (!isPlotLockHeld)
+			lock.lock();
+		/* thread-safe part */
+		plot->updateSeries();
+		plot->addTimePoint(timestamp);
+	}
+}
+
+void ViewerDataHandler::compileWatches()
+{
+	watchVariables.clear();
+
+	size_t compiled = watchEngine.compile([this](const std::string& variableName) -> int32_t
+										  {
+		if (!variableHandler->contains(variableName))
+		{
+			logger->warn("Watch variable {} not found, watch skipped!", variableName);
+			return -1;
+		}
+
+		Variable* var = variableHandler->getVariable(variableName).get();
+		auto it = std::find(watchVariables.begin(), watchVariables.end(), var);
+		if (it != watchVariables.end())
+			return std::distance(watchVariables.begin(), it);
+
+		watchVariables.push_back(var);
+		return watchVariables.size() - 1; });
+
+	watchValues.assign(watchVariables.size(), 0.0);
+	if (compiled > 0)
+		logger->info("{} watch(es) active", compiled);
+}
+
+void ViewerDataHandler::processWatches(double timestamp)
+{
+	if (watchEngine.isEmpty())
+		return;
+
+	for (size_t i = 0; i < watchVariables.size(); i++)
+		watchValues[i] = watchVariables[i]->getValue();
+
+	if (watchEngine.process(timestamp, watchValues))
+	{
+		logger->info("Watch hit. Stopping.");
+		haltPipeline();
+	}
+}
+
+bool ViewerDataHandler::readFrame(RawFrame& frame, uint32_t dueRateClasses)
+{
+	const SamplePlan& plan = *samplePlan;
+	frame.plan = samplePlan;
+	frame.dueRateClasses = dueRateClasses;
+	frame.rttRecords.clear();
+	frame.values.resize(plan.sampleList.size());
+	frame.isValid.assign(plan.sampleList.size(), 0);
+
+	/* sample by address - only the entries required by the rate classes due in this tick */
+	dueReads.clear();
+	dueIndices.clear();
+	for (size_t i = 0; i < plan.sampleList.size(); i++)
+	{
+		if (!(plan.sampleRateClasses[i] & dueRateClasses))
+			continue;
+
+		dueReads.push_back(plan.sampleList[i]);
+		dueIndices.push_back(i);
+	}
+
+	if (dueReads.empty())
+		return true;
+
+	dueValues.resize(dueReads.size());
+	auto readStart = std::chrono::steady_clock::now();
+	if (!debugProbe->readMemoryBatch(dueReads, dueValues.data()))
+		return false;
+
+	/* one measurement for the whole tick keeps the planner lock out of the per-read loop */
+	samplingPlanner.addMeasurement(dueReads, std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - readStart).count());
+
+	for (size_t i = 0; i < dueReads.size(); i++)
+	{
+		frame.values[dueIndices[i]] = dueValues[i];
+		frame.isValid[dueIndices[i]] = 1;
+	}
+	return true;
+}
+
+bool ViewerDataHandler::readArrays(RawFrame& frame, uint32_t dueRateClasses)
+{
+	SamplePlan& plan = *samplePlan;
+	frame.arrayOffsets.resize(plan.arrayReads.size());
+	frame.isArrayValid.assign(plan.arrayReads.size(), 0);
+
+	uint32_t offset = 0;
+	for (size_t i = 0; i < plan.arrayReads.size(); i++)
+	{
+		auto& array = plan.arrayReads[i];
+		if (!(array.rateClassMask & dueRateClasses))
+			continue;
+
+		const uint32_t size = array.length * array.element.getSize();
+		frame.arrayOffsets[i] = offset;
+
+		/* single word reads write the whole word into the buffer */
+		if (frame.arrayData.size() < offset + std::max<uint32_t>(size, sizeof(uint32_t)))
+			frame.arrayData.resize(offset + std::max<uint32_t>(size, sizeof(uint32_t)));
+
+		if (!debugProbe->readMemory(array.address, frame.arrayData.data() + offset, size))
+		{
+			logger->error("Could not read array {}!", array.seriesName);
+			return false;
+		}
+
+		frame.isArrayValid[i] = 1;
+		offset += std::max<uint32_t>(size, sizeof(uint32_t));
+	}
+	return true;
+}
+
+void ViewerDataHandler::pushFrame(const IDebugProbe::Frame& entry, double timestamp, uint32_t dueRateClasses)
+{
+	RawFrame* frame = rawFrames->queue.getWriteSlot();
+	if (frame == nullptr)
+	{
+		rawFrames->dropped++;
+		return;
+	}
+
+	const SamplePlan& plan = *samplePlan;
+	frame->timestamp = timestamp;
+	frame->plan = samplePlan;
+	frame->dueRateClasses = dueRateClasses;
+	frame->isArrayValid.clear();
+	frame->rttRecords.clear();
+
+	/* the probe may sample only the beginning of a long sample list */
+	const size_t count = std::min(entry.values.size(), plan.sampleList.size());
+	frame->values.resize(plan.sampleList.size());
+	std::copy(entry.values.begin(), entry.values.begin() + count, frame->values.begin());
+	frame->isValid.assign(plan.sampleList.size(), 0);
+	std::fill(frame->isValid.begin(), frame->isValid.begin() + count, 1);
+
+	rawFrames->queue.commitWrite();
+}
+
+void ViewerDataHandler::publishArrays(RawFrame& frame)
+{
+	for (size_t i = 0; i < frame.isArrayValid.size(); i++)
+	{
+		if (!frame.isArrayValid[i])
+			continue;
+
+		auto& array = frame.plan->arrayReads[i];
+		const uint8_t elementSize = array.element.getSize();
+		const uint8_t* data = frame.arrayData.data() + frame.arrayOffsets[i];
+
+		arrayFrame.resize(array.length);
+		for (uint32_t j = 0; j < array.length; j++)
+		{
+			uint32_t raw = 0;
+			std::memcpy(&raw, &data[j * elementSize], elementSize);
+			array.element.setRawValue(raw);
+			arrayFrame[j] = array.element.transformToDouble();
+		}
+
+		std::lock_guard<std::mutex> lock(*mtx);
+		array.plot->addArrayFrame(array.seriesName, arrayFrame);
+	}
+}
+
+void ViewerDataHandler::startPipeline()
+{
+	stopPipeline();
+
+	rawFrames->reset();
+	logFrames->reset();
+	isPipelineHalted = false;
+	isBurstReplay = false;
+	isPipelineRunning = true;
+	isLoggingRunning = true;
+
+	processingHandle = std::thread(&ViewerDataHandler::processingStage, this);
+	loggingHandle = std::thread(&ViewerDataHandler::loggingStage, this);
+}
+
+void ViewerDataHandler::stopPipeline()
+{
+	/* the processing stage drains the queued frames before the logging stage is stopped */
+	isPipelineRunning = false;
+	if (processingHandle.joinable())
+		processingHandle.join();
+
+	isLoggingRunning = false;
+	if (loggingHandle.joinable())
+		loggingHandle.join();
+}
+
+void ViewerDataHandler::haltPipeline()
+{
+	isPipelineHalted = true;
+	viewerState = State::STOP;
+	stateChangeOrdered = true;
+}
+
+void ViewerDataHandler::processingStage()
+{
+	while (true)
+	{
+		RawFrame* frame = rawFrames->queue.front();
+
+		if (frame == nullptr)
+		{
+			if (!isPipelineRunning)
+				break;
+			std::this_thread::sleep_for(std::chrono::microseconds(stageIdleSleepUs));
+			continue;
+		}
+
+		rawFrames->maxDepth = std::max(rawFrames->maxDepth.load(), rawFrames->queue.size());
+
+		/* the acquisition was stopped by a trigger or a watch - the rest of the queue is after the stop */
+		if (!isPipelineHalted)
+			processFrame(*frame);
+
+		rawFrames->frames++;
+		rawFrames->queue.popFront();
+	}
+}
+
+void ViewerDataHandler::processFrame(RawFrame& frame)
+{
+	processingPlan = frame.plan;
+	applyRttRecords(frame);
+	updateVariables(frame.timestamp, frame.values, frame.isValid, frame.dueRateClasses);
+	publishArrays(frame);
+}
+
+void ViewerDataHandler::logFrame(double timestamp)
+{
+	LogFrame* frame = logFrames->queue.getWriteSlot();
+	while (frame == nullptr && isBurstReplay)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(stageIdleSleepUs));
+		frame = logFrames->queue.getWriteSlot();
+	}
+
+	if (frame == nullptr)
+	{
+		logFrames->dropped++;
+		return;
+	}
+
+	frame->timestamp = timestamp;
+	frame->values.resize(logHeader.size());
+	for (size_t i = 0; i < logHeader.size(); i++)
+	{
+		auto value = csvEntry.find(logHeader[i]);
+		frame->values[i] = value != csvEntry.end() ? value->second : 0.0;
+	}
+
+	logFrames->queue.commitWrite();
+}
+
+void ViewerDataHandler::loggingStage()
+{
+	while (true)
+	{
+		LogFrame* frame = logFrames->queue.front();
+
+		if (frame == nullptr)
+		{
+			if (!isLoggingRunning)
+				break;
+			std::this_thread::sleep_for(std::chrono::microseconds(stageIdleSleepUs));
+			continue;
+		}
+
+		logFrames->maxDepth = std::max(logFrames->maxDepth.load(), logFrames->queue.size());
+		csvStreamer->writeLine(frame->timestamp, frame->values);
+		logFrames->frames++;
+		logFrames->queue.popFront();
+	}
+}
+
+ViewerDataHandler::PipelineStatistics ViewerDataHandler::getPipelineStatistics() const
 {
-	settings = newSettings;
-	plotHandler->setMaxPoints(settings.maxPoints);
+	return {rawFrames->getStatistics(), logFrames->getStatistics()};
 }
 
-void ViewerDataHandler::updateVariables(double timestamp, const std::unordered_map<uint32_t, double>& values)
+void ViewerDataHandler::handleTrigger(double timestamp, const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid, uint32_t dueRateClasses)
 {
-	/* get raw values and put them into variables based on addresses */
-	for (std::shared_ptr<Variable> var : *variableHandler)
+	auto triggerSettings = trigger.getSettings();
+
+	if (triggerState == TriggerState::TRIGGERED)
 	{
-		uint32_t address = var->getAddress();
-		if (values.contains(address))
-			var->setRawValue(values.at(address));
+		updatePlots(timestamp, dueRateClasses);
+
+		if (++postTriggerCnt < triggerSettings.postTriggerPoints)
+			return;
+
+		if (triggerSettings.rearm)
+		{
+			logger->info("After-trigger samples collected. Rearming.");
+			armTrigger();
+		}
+		else
+		{
+			logger->info("After-trigger samples collected. Stopping.");
+			haltPipeline();
+		}
+		return;
 	}
 
-	for (std::shared_ptr<Variable> var : *variableHandler)
+	const int32_t slot = processingPlan->triggerSlot;
+
+	if (slot < 0 || !isValid[slot] || !trigger.check(processingPlan->triggerVariable->getValue(), values[slot]))
 	{
-		uint32_t address = var->getAddress();
-		if (values.contains(address))
-			csvEntry[var->getName()] = var->transformToDouble();
+		if (preTriggerFrames.empty())
+			return;
+
+		/* when full the oldest slot is overwritten, the vectors keep their capacity so nothing is allocated */
+		Frame& frame = preTriggerFrames[(preTriggerHead + preTriggerCount) % preTriggerFrames.size()];
+		if (preTriggerCount < preTriggerFrames.size())
+			preTriggerCount++;
+		else
+			preTriggerHead = (preTriggerHead + 1) % preTriggerFrames.size();
+
+		frame.timestamp = timestamp;
+		frame.plan = processingPlan;
+		frame.values.assign(values.begin(), values.end());
+		frame.isValid.assign(isValid.begin(), isValid.end());
+		frame.dueRateClasses = dueRateClasses;
+		return;
 	}
 
-	for (auto plot : *plotHandler)
+	logger->info("Trigger!");
+
+	/* the previous capture is replaced by the pre-trigger history */
 	{
-		std::lock_guard<std::mutex> lock(*mtx);
-		/* thread-safe part */
-		plot->updateSeries();
-		plot->addTimePoint(timestamp);
+		std::unique_lock<std::mutex> lock(*mtx, std::defer_lock);
+		if (!isPlotLockHeld)
+			lock.lock();
+		plotHandler->eraseAllPlotData();
 	}
 
-	if (settings.shouldLog)
-		csvStreamer->writeLine(timestamp, csvEntry);
+	/* the history is evaluated only now, every frame with the plan it was sampled with */
+	auto currentPlan = processingPlan;
+	for (size_t i = 0; i < preTriggerCount; i++)
+	{
+		Frame& frame = preTriggerFrames[(preTriggerHead + i) % preTriggerFrames.size()];
+		processingPlan = frame.plan;
+		evaluateVariables(frame.values, frame.isValid);
+		updatePlots(frame.timestamp, frame.dueRateClasses);
+	}
+	processingPlan = currentPlan;
+	preTriggerHead = 0;
+	preTriggerCount = 0;
+
+	/* restore the values of the triggering sample */
+	evaluateVariables(values, isValid);
+	updatePlots(timestamp, dueRateClasses);
+
+	triggerState = TriggerState::TRIGGERED;
+	postTriggerCnt = 0;
+}
+
+void ViewerDataHandler::armTrigger()
+{
+	trigger.reset();
+	triggerState = TriggerState::ARMED;
+	preTriggerFrames.resize(trigger.getSettings().preTriggerPoints);
+	preTriggerHead = 0;
+	preTriggerCount = 0;
+	postTriggerCnt = 0;
 }
 
 void ViewerDataHandler::dataHandler()
@@ -95,43 +820,100 @@ void ViewerDataHandler::dataHandler()
 	{
 		if (viewerState == State::RUN)
 		{
+			if (isSamplePlanPending)
+				swapPendingSamplePlan();
+
+			processWriteRequests();
+
 			double period = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+			handleStimulus(period);
+
+			if (settings.pointerRefreshFrequencyHz > 0 && period > pointerRefreshTime)
+			{
+				refreshPointerChains();
+				pointerRefreshTime = period + 1.0 / settings.pointerRefreshFrequencyHz;
+			}
+
+			if (settings.burstMode && probeSettings.mode == IDebugProbe::Mode::NORMAL)
+			{
+				captureBurst(start);
+				viewerState = State::STOP;
+				stateChangeOrdered = true;
+			}
 
-			if (probeSettings.mode == IDebugProbe::Mode::HSS)
+			else if (probeSettings.mode == IDebugProbe::Mode::HSS)
 			{
 				if (!debugProbe->isValid())
 					setState(State::STOP);
 
-				auto maybeEntry = debugProbe->readSingleEntry();
+				const size_t count = debugProbe->readEntries(hssFrames);
+				bool pointersChanged = false;
 
-				if (!maybeEntry.has_value())
-					continue;
+				for (size_t i = 0; i < count; i++)
+				{
+					auto& entry = hssFrames[i];
+					double timestamp = entry.timestamp;
 
-				auto [timestamp, rawValues] = maybeEntry.value();
+					/* CYCCNT is the first entry of the sample list */
+					if (settings.useTargetTimestamps && !entry.values.empty() && samplePlan->sampleList[0].first == CycleCounter::dwtCyccntAddress)
+						timestamp = cycleCounter.update(entry.values[0]);
 
-				updateVariables(timestamp, rawValues);
+					pointersChanged = pointersChanged || havePointersChanged(*samplePlan, entry.values);
 
-				/* filter sampling frequency */
-				averageSamplingPeriod = samplingPeriodFilter.filter((period - lastT));
-				lastT = period;
-				timer++;
+					/* HSS samples everything at the base rate - slower plots are decimated */
+					pushFrame(entry, timestamp, getDueRateClasses(timer));
+
+					/* filter sampling frequency with the probe timestamps as the entries come in batches */
+					averageSamplingPeriod = samplingPeriodFilter.filter((entry.timestamp - lastT));
+					lastT = entry.timestamp;
+					timer++;
+				}
+
+				/* the whole batch was sampled with the current plan, the new one applies to the next batch */
+				if (pointersChanged)
+					refreshPointerChains();
 			}
 
 			else if (period > ((1.0 / settings.sampleFrequencyHz) * timer))
 			{
-				std::unordered_map<uint32_t, double> rawValues;
+				const double latencyUs = (period - (1.0 / settings.sampleFrequencyHz) * timer) * 1e6;
+				meanSchedulingLatencyUs = schedulingLatencyFilter.filter(latencyUs);
+				if (latencyUs > maxSchedulingLatencyUs)
+					maxSchedulingLatencyUs = latencyUs;
+
+				uint32_t dueRateClasses = getDueRateClasses(timer);
+
+				/* the probe stage never waits for the processing stage - the tick is read and dropped if the queue is full */
+				RawFrame* frame = rawFrames->queue.getWriteSlot();
+				RawFrame& rawFrame = frame != nullptr ? *frame : droppedFrame;
 
-				/* sample by address */
-				for (auto& [address, size] : sampleList)
+				if (!readFrame(rawFrame, dueRateClasses) || !readArrays(rawFrame, dueRateClasses))
+					setState(State::STOP);
+				else
 				{
-					uint32_t value = 0;
-					if (debugProbe->readMemory(address, (uint8_t*)&value, size))
-						rawValues[address] = value;
+					/* CYCCNT is the first entry of the sample list so it is read in the same pass as the variables */
+					if (settings.useTargetTimestamps && !rawFrame.values.empty() && rawFrame.isValid[0] && samplePlan->sampleList[0].first == CycleCounter::dwtCyccntAddress)
+						rawFrame.timestamp = cycleCounter.update(rawFrame.values[0]);
+					else
+						rawFrame.timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+					const bool pointersChanged = havePointersChanged(rawFrame);
+
+					if (rttReader != nullptr && period > rttReadTime)
+					{
+						readRtt(rawFrame);
+						rttReadTime = period + 1.0 / settings.rtt.readFrequencyHz;
+					}
+
+					if (frame != nullptr)
+						rawFrames->queue.commitWrite();
 					else
-						setState(State::STOP);
+						rawFrames->dropped++;
+
+					/* the queued frame keeps the plan it was read with */
+					if (pointersChanged)
+						refreshPointerChains();
 				}
-				double timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
-				updateVariables(timestamp, rawValues);
 
 				/* filter sampling frequency */
 				averageSamplingPeriod = samplingPeriodFilter.filter((period - lastT));
@@ -146,21 +928,53 @@ void ViewerDataHandler::dataHandler()
 		{
 			if (viewerState == State::RUN)
 			{
+				std::string threadErrorMsg;
+				if (!ThreadPriority::apply(settings.threadPriority, threadErrorMsg))
+					logger->warn("Viewer acquisition thread: {}", threadErrorMsg);
+				schedulingLatencyFilter = MovingAverage{1000};
+				meanSchedulingLatencyUs = 0.0;
+				maxSchedulingLatencyUs = 0.0;
+
 				createSampleList();
+				compileWatches();
 				prepareCSVFile();
 
-				if (debugProbe->startAcqusition(probeSettings, sampleList, settings.sampleFrequencyHz))
+				if (debugProbe->startAcqusition(probeSettings, samplePlan->sampleList, settings.sampleFrequencyHz))
 				{
 					timer = 0;
 					lastT = 0.0;
 					start = std::chrono::steady_clock::now();
+					cycleCounter.reset();
+					cycleCounter.setCoreFrequency(settings.coreFrequency * 1000);
+
+					trigger.setSettings(settings.trigger);
+					armTrigger();
+					prepareStimulus();
+
+					if (settings.useTargetTimestamps && !enableCycleCounter())
+						logger->warn("Could not enable DWT cycle counter, timestamps will be invalid!");
+
+					/* pointers can be read only after the probe is connected */
+					pointerRefreshTime = 0.0;
+					if (resolvePointerChains())
+					{
+						createSampleList();
+						debugProbe->updateSampleList(samplePlan->sampleList, settings.sampleFrequencyHz);
+					}
+
+					prepareRtt();
+
+					/* the processing stage uses the trigger and the watches armed above */
+					startPipeline();
 				}
 				else
 					viewerState = State::STOP;
 			}
 			else
 			{
+				cancelWriteRequests();
 				debugProbe->stopAcqusition();
+				stopPipeline();
 				if (settings.shouldLog)
 					csvStreamer->finishLogging();
 			}
@@ -171,61 +985,499 @@ void ViewerDataHandler::dataHandler()
 
 void ViewerDataHandler::createSampleList()
 {
-	sampleList.clear();
+	/* plans of all groups are ready before the start so that switching the group does not stall the acquisition */
+	{
+		std::lock_guard<std::mutex> lock(samplePlanMtx);
+		samplePlanCache.clear();
+	}
+	for (auto& [name, group] : *plotGroupHandler)
+		getCachedSamplePlan(*group);
+
+	isSamplePlanPending = false;
+	applySamplePlan(SamplePlan(getCachedSamplePlan(*plotGroupHandler->getActiveGroup())));
+}
+
+const ViewerDataHandler::SamplePlan& ViewerDataHandler::getCachedSamplePlan(PlotGroup& group)
+{
+	/* the cache is written by the acquisition thread only, the lock is held for the readers on the GUI thread */
+	const size_t signature = getSamplePlanSignature(group);
+	auto it = samplePlanCache.find(group.getName());
+	if (it != samplePlanCache.end() && it->second.signature == signature)
+		return it->second;
+
+	auto plan = createSamplePlan(group);
+	std::lock_guard<std::mutex> lock(samplePlanMtx);
+	auto& cached = samplePlanCache[group.getName()];
+	cached = std::move(plan);
+	return cached;
+}
+
+SamplingPlanner::Estimate ViewerDataHandler::getSamplingEstimate()
+{
+	samplingPlanner.setProbe(probeSettings.debugProbe, probeSettings.speedkHz);
+
+	if (plotGroupHandler->getGroupCount() == 0)
+		return SamplingPlanner::Estimate{};
+
+	auto activeGroup = plotGroupHandler->getActiveGroup();
+	const size_t planSignature = getSamplePlanSignature(*activeGroup);
+	size_t signature = planSignature ^ (std::hash<uint32_t>{}(probeSettings.speedkHz) << 1) ^ (std::hash<uint32_t>{}(probeSettings.debugProbe) << 2) ^ samplingPlanner.isCalibrated();
+
+	if (signature == samplingEstimateSignature)
+		return samplingEstimate;
+
+	/* a running acquisition owns the pointer chains, its cached plan is used and the estimate waits until the plan is rebuilt */
+	SamplePlan plan;
+	{
+		std::lock_guard<std::mutex> lock(samplePlanMtx);
+		auto it = samplePlanCache.find(activeGroup->getName());
+		if (it != samplePlanCache.end() && it->second.signature == planSignature)
+			plan = it->second;
+		else if (viewerState == State::RUN)
+			return samplingEstimate;
+	}
+
+	if (plan.signature != planSignature)
+		plan = createSamplePlan(*activeGroup);
+
+	std::vector<SamplingPlanner::Entry> entries;
+
+	for (size_t i = 0; i < plan.sampleList.size(); i++)
+	{
+		/* entries shared by several rate classes are read with the fastest one */
+		uint32_t divider = std::numeric_limits<uint32_t>::max();
+		for (size_t j = 0; j < plan.rateClasses.size(); j++)
+			if (plan.sampleRateClasses[i] & (1u << j))
+				divider = std::min(divider, plan.rateClasses[j].divider);
+
+		entries.push_back({plan.sampleList[i].first, plan.sampleList[i].second, divider == std::numeric_limits<uint32_t>::max() ? 1 : divider});
+	}
+
+	samplingEstimate = samplingPlanner.estimate(entries, settings.sampleFrequencyHz);
+	samplingEstimateSignature = signature;
+	return samplingEstimate;
+}
+
+bool ViewerDataHandler::isSamplingEstimateCalibrated() const
+{
+	return samplingPlanner.isCalibrated();
+}
+
+void ViewerDataHandler::refreshSampleList()
+{
+	/* only the request is posted, the plan is built on the acquisition thread that owns the pointer chains and the cache */
+	auto activeGroup = plotGroupHandler->getActiveGroup();
+	std::string groupName = activeGroup->getName();
+	size_t signature = getSamplePlanSignature(*activeGroup);
+
+	if (groupName == requestedSamplePlanGroup && signature == requestedSamplePlanSignature)
+		return;
+
+	requestedSamplePlanGroup = groupName;
+	requestedSamplePlanSignature = signature;
+	isSamplePlanPending = true;
+}
+
+void ViewerDataHandler::swapPendingSamplePlan()
+{
+	isSamplePlanPending = false;
+
+	auto start = std::chrono::steady_clock::now();
+	auto activeGroup = plotGroupHandler->getActiveGroup();
+	const SamplePlan& plan = getCachedSamplePlan(*activeGroup);
+
+	if (plan.signature == samplePlan->signature)
+		return;
+
+	applySamplePlan(SamplePlan(plan));
+	updateProbeSampleList();
+	logger->info("Sample list of group {} applied in {} us", activeGroup->getName(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void ViewerDataHandler::updateProbeSampleList()
+{
+	if (!debugProbe->updateSampleList(samplePlan->sampleList, settings.sampleFrequencyHz))
+	{
+		logger->error("Could not update the sample list of a running acquisition!");
+		viewerState = State::STOP;
+		stateChangeOrdered = true;
+	}
+}
+
+void ViewerDataHandler::applySamplePlan(SamplePlan&& plan)
+{
+	samplePlan = std::make_shared<SamplePlan>(std::move(plan));
+
+	/* mark actively sampled varaibles */
+	for (auto variable : *variableHandler)
+	{
+		variable->setIsCurrentlySampled(false);
+		if (std::find(samplePlan->sampleList.begin(), samplePlan->sampleList.end(), std::pair<uint32_t, uint8_t>(variable->getSampleAddress(), variable->getSize())) != samplePlan->sampleList.end())
+			variable->setIsCurrentlySampled(true);
+	}
+
+	for (auto& array : samplePlan->arrayReads)
+		array.plot->getSeries(array.seriesName)->var->setIsCurrentlySampled(true);
+
+	if (!samplePlan->arrayReads.empty() && probeSettings.mode == IDebugProbe::Mode::HSS)
+		logger->warn("Array plots are sampled in normal mode only!");
+
+	for (auto& rateClass : samplePlan->rateClasses)
+		logger->info("Rate class: every {} tick(s), phase {}", rateClass.divider, rateClass.phase);
+}
+
+size_t ViewerDataHandler::getSamplePlanSignature(PlotGroup& group) const
+{
+	size_t signature = 0;
+	auto combine = [&signature](size_t value)
+	{ signature ^= value + 0x9e3779b9 + (signature << 6) + (signature >> 2); };
+
+	combine(settings.sampleFrequencyHz);
+	combine(settings.useTargetTimestamps);
+	combine(std::hash<std::string>{}(settings.trigger.variableName));
+	combine(std::hash<std::string>{}(settings.rtt.channelVariables));
+	combine(settings.rtt.enabled);
+
+	for (auto& [name, plotElem] : group)
+	{
+		auto plot = plotElem.plot;
+		combine(std::hash<const Plot*>{}(plot.get()));
+		combine(plotElem.visibility);
+		combine(plot->getSampleFrequency());
+		combine(static_cast<size_t>(plot->getType()));
+		combine(plot->getArrayLength());
+		combine(std::hash<const Variable*>{}(plot->getXAxisVariable()));
+
+		for (auto& [name, ser] : plot->getSeriesMap())
+		{
+			combine(ser->visible);
+			combine(ser->var->getSampleAddress());
+			combine(ser->var->getSize());
+		}
+	}
+
+	for (auto variable : *variableHandler)
+		if (variable->getFractional().baseVariable != nullptr)
+			combine(variable->getFractional().baseVariable->getSampleAddress());
+
+	for (auto& [name, plotElem] : group)
+		for (auto& [name, ser] : plotElem.plot->getSeriesMap())
+			combine(ser->var->isAddressResolved());
+
+	/* variables sampled or written regardless of the plots */
+	auto combineVariable = [&](const std::string& variableName)
+	{
+		if (!variableHandler->contains(variableName))
+			return;
+		auto var = variableHandler->getVariable(variableName);
+		combine(var->getSampleAddress());
+		combine(var->isAddressResolved());
+	};
+
+	combineVariable(settings.trigger.variableName);
+	combineVariable(settings.stimulus.variableName);
+
+	for (auto& watch : watchEngine.getWatches())
+	{
+		combine(watch.enabled);
+		combineVariable(watch.variableName);
+	}
+
+	return signature;
+}
+
+ViewerDataHandler::SamplePlan ViewerDataHandler::createSamplePlan(PlotGroup& group)
+{
+	SamplePlan plan{};
+	plan.signature = getSamplePlanSignature(group);
+
+	/* class 0 is always the base sampling rate */
+	getRateClass(plan, 1);
+
+	auto addElement = [&](std::pair<uint32_t, uint8_t> newElement, uint32_t rateClassMask)
+	{
+		auto it = std::find(plan.sampleList.begin(), plan.sampleList.end(), newElement);
 
-	auto checkIfElementExists = [&](std::pair<uint32_t, uint8_t> newElement)
+		if (it == plan.sampleList.end())
+		{
+			plan.sampleList.push_back(newElement);
+			plan.sampleRateClasses.push_back(rateClassMask);
+		}
+		else
+			plan.sampleRateClasses[std::distance(plan.sampleList.begin(), it)] |= rateClassMask;
+	};
+
+	/* root pointers are compared with the values they were resolved with to detect a moved chain */
+	std::vector<uint32_t> rootPointers;
+	auto addRootPointer = [&](Variable* var, uint32_t rateClassMask)
 	{
-		return std::find_if(sampleList.begin(), sampleList.end(), [&newElement](const std::pair<uint32_t, uint8_t>& element)
-							{ return element == newElement; }) != sampleList.end();
+		addElement({var->getAddress(), sizeof(uint32_t)}, rateClassMask);
+		if (std::find(rootPointers.begin(), rootPointers.end(), var->getAddress()) == rootPointers.end())
+			rootPointers.push_back(var->getAddress());
 	};
 
-	for (auto& [name, plotElem] : *plotGroupHandler->getActiveGroup())
+	std::vector<Variable*> sampledVariables;
+
+	/* variables bound to RTT channels are updated by the records, never read from the memory */
+	const auto rttChannelNames = getRttChannelNames();
+	auto isRttChannel = [&rttChannelNames](Variable* var)
+	{ return std::find(rttChannelNames.begin(), rttChannelNames.end(), var->getName()) != rttChannelNames.end(); };
+
+	for (auto& [name, plotElem] : group)
 	{
 		auto plot = plotElem.plot;
 
 		if (!plotElem.visibility)
 			continue;
 
+		size_t rateClass = getRateClass(plan, calculateSampleDivider(settings.sampleFrequencyHz, plot->getSampleFrequency()));
+		plan.plotRateClass[plot.get()] = rateClass;
+		uint32_t rateClassMask = 1u << rateClass;
+
 		for (auto& [name, ser] : plot->getSeriesMap())
 		{
-			if (!ser->visible)
+			if (!ser->visible || !ser->var->isAddressResolved() || isRttChannel(ser->var))
+				continue;
+
+			if (plot->getType() == Plot::Type::ARRAY)
+			{
+				uint32_t length = plot->getArrayLength();
+				if (length * ser->var->getSize() > maxArraySize)
+				{
+					length = maxArraySize / std::max<uint8_t>(1, ser->var->getSize());
+					logger->warn("Array {} limited to {} elements", name, length);
+				}
+				plan.arrayReads.push_back({plot, name, *ser->var, ser->var->getSampleAddress(), length, rateClassMask});
+
+				if (ser->var->isPointerChain())
+					addRootPointer(ser->var, rateClassMask);
 				continue;
+			}
 
-			std::pair<uint32_t, uint8_t> newElement = {ser->var->getAddress(), ser->var->getSize()};
+			addElement({ser->var->getSampleAddress(), ser->var->getSize()}, rateClassMask);
+			sampledVariables.push_back(ser->var);
 
-			if (!checkIfElementExists(newElement))
-				sampleList.push_back(newElement);
+			/* root pointer is watched so that the chain is resolved again as soon as it changes */
+			if (ser->var->isPointerChain())
+				addRootPointer(ser->var, rateClassMask);
 
 			Variable* maybeXAxisVariable = plot->getXAxisVariable();
 			if (plot->getType() == Plot::Type::XY && maybeXAxisVariable != nullptr)
 			{
-				newElement = {maybeXAxisVariable->getAddress(), maybeXAxisVariable->getSize()};
-				if (!checkIfElementExists(newElement))
-					sampleList.push_back(newElement);
+				addElement({maybeXAxisVariable->getSampleAddress(), maybeXAxisVariable->getSize()}, rateClassMask);
+				sampledVariables.push_back(maybeXAxisVariable);
 			}
 		}
 	}
 
-	/* additionally scan for eventual bases of fractional variables that should be sampled */
-	for (auto variable : *variableHandler)
+	/* trigger variable has to be available in every tick */
+	if (settings.trigger.type != VariableTrigger::Type::DISABLED)
 	{
-		if (variable->getFractional().baseVariable != nullptr)
+		if (variableHandler->contains(settings.trigger.variableName))
 		{
-			auto var = variable->getFractional().baseVariable;
-			std::pair<uint32_t, uint8_t> newElement = {var->getAddress(), var->getSize()};
+			plan.triggerVariable = variableHandler->getVariable(settings.trigger.variableName);
+			if (plan.triggerVariable->isPointerChain())
+				addRootPointer(plan.triggerVariable.get(), allRateClasses);
+			if (plan.triggerVariable->isAddressResolved())
+			{
+				addElement({plan.triggerVariable->getSampleAddress(), plan.triggerVariable->getSize()}, allRateClasses);
+				sampledVariables.push_back(plan.triggerVariable.get());
+			}
+		}
+		else
+			logger->warn("Trigger variable {} not found, trigger disabled!", settings.trigger.variableName);
+	}
+
+	/* watches are evaluated on every sample */
+	for (auto& watch : watchEngine.getWatches())
+	{
+		if (!watch.enabled || !variableHandler->contains(watch.variableName))
+			continue;
+
+		auto var = variableHandler->getVariable(watch.variableName);
+		if (var->isPointerChain())
+			addRootPointer(var.get(), allRateClasses);
+		if (!var->isAddressResolved())
+			continue;
+
+		addElement({var->getSampleAddress(), var->getSize()}, allRateClasses);
+		sampledVariables.push_back(var.get());
+	}
+
+	/* the stimulus is not sampled, only the root pointer of its chain is watched so the writes follow it */
+	if (settings.stimulus.type != StimulusGenerator::Type::DISABLED && variableHandler->contains(settings.stimulus.variableName))
+	{
+		auto var = variableHandler->getVariable(settings.stimulus.variableName);
+		if (var->isPointerChain())
+			addRootPointer(var.get(), allRateClasses);
+	}
+
+	/* bases of fractional variables are sampled in every tick as any rate class may need them */
+	std::vector<Variable*> cyclic;
+	plan.evaluationOrder = Variable::sortByBaseDependency(sampledVariables, cyclic);
+
+	for (auto var : cyclic)
+		logger->warn("Fractional base chain of {} is cyclic, previous base value will be used!", var->getName());
+
+	for (auto var : plan.evaluationOrder)
+	{
+		auto base = var->getFractional().baseVariable;
+		if (base != nullptr)
+			addElement({base->getSampleAddress(), base->getSize()}, allRateClasses);
+	}
+
+	/* cycle counter goes first so that its readout is as close as possible to the start of the tick */
+	if (settings.useTargetTimestamps)
+	{
+		plan.sampleList.insert(plan.sampleList.begin(), {CycleCounter::dwtCyccntAddress, 4});
+		plan.sampleRateClasses.insert(plan.sampleRateClasses.begin(), allRateClasses);
+	}
+
+	/* the processing stage reads the values by position, the addresses may change while the frames are queued */
+	auto getSlot = [&plan](Variable* var) -> int32_t
+	{
+		auto it = std::find(plan.sampleList.begin(), plan.sampleList.end(), std::pair<uint32_t, uint8_t>(var->getSampleAddress(), var->getSize()));
+		return it == plan.sampleList.end() ? -1 : static_cast<int32_t>(std::distance(plan.sampleList.begin(), it));
+	};
+
+	for (auto var : plan.evaluationOrder)
+		plan.evaluationSlots.push_back(getSlot(var));
+
+	if (plan.triggerVariable != nullptr)
+		plan.triggerSlot = getSlot(plan.triggerVariable.get());
+
+	for (auto address : rootPointers)
+	{
+		auto it = std::find(plan.sampleList.begin(), plan.sampleList.end(), std::pair<uint32_t, uint8_t>(address, sizeof(uint32_t)));
+		if (it != plan.sampleList.end())
+			plan.rootPointerSlots.push_back(static_cast<uint32_t>(std::distance(plan.sampleList.begin(), it)));
+	}
+
+	return plan;
+}
+
+size_t ViewerDataHandler::getRateClass(SamplePlan& plan, uint32_t divider)
+{
+	auto it = std::find_if(plan.rateClasses.begin(), plan.rateClasses.end(), [divider](const RateClass& rateClass)
+						   { return rateClass.divider == divider; });
+
+	if (it != plan.rateClasses.end())
+		return std::distance(plan.rateClasses.begin(), it);
+
+	if (plan.rateClasses.size() >= maxRateClasses)
+	{
+		logger->warn("Too many different plot sampling frequencies, using the base rate for divider {}", divider);
+		return 0;
+	}
+
+	/* spread the classes over different ticks so that slow reads do not pile up on the same tick */
+	plan.rateClasses.push_back({divider, static_cast<uint32_t>(plan.rateClasses.size() % divider)});
+	return plan.rateClasses.size() - 1;
+}
+
+uint32_t ViewerDataHandler::getDueRateClasses(uint32_t tick) const
+{
+	uint32_t dueRateClasses = 0;
+
+	for (size_t i = 0; i < samplePlan->rateClasses.size(); i++)
+		if (samplePlan->rateClasses[i].isDue(tick))
+			dueRateClasses |= (1u << i);
+
+	return dueRateClasses;
+}
+
+bool ViewerDataHandler::resolvePointerChains()
+{
+	bool changed = false;
+	rootPointerValues.clear();
+
+	auto readPointer = [&](uint32_t address, uint32_t& pointer)
+	{
+		return debugProbe->readMemory(address, (uint8_t*)&pointer, sizeof(uint32_t));
+	};
+
+	for (std::shared_ptr<Variable> var : *variableHandler)
+	{
+		if (!var->isPointerChain())
+			continue;
+
+		uint32_t previousAddress = var->getSampleAddress();
+		bool wasResolved = var->isAddressResolved();
 
-			if (!checkIfElementExists(newElement))
-				sampleList.push_back(newElement);
+		if (!var->resolveAddress(readPointer) && wasResolved)
+			logger->warn("Could not resolve pointer chain of {}", var->getName());
+
+		if (var->isAddressResolved() != wasResolved || var->getSampleAddress() != previousAddress)
+		{
+			logger->info("Variable {} resolved to 0x{:08x}", var->getName(), var->getSampleAddress());
+			changed = true;
 		}
+
+		/* remember the root pointer to detect its changes in the sampled data */
+		uint32_t rootPointer = 0;
+		if (readPointer(var->getAddress(), rootPointer))
+			rootPointerValues[var->getAddress()] = rootPointer;
 	}
 
-	/* mark actively sampled varaibles */
-	for (auto variable : *variableHandler)
+	return changed;
+}
+
+void ViewerDataHandler::refreshPointerChains()
+{
+	if (!resolvePointerChains())
+		return;
+
+	/* rebuilt right away as the current plan samples the previous addresses, the GUI may not be running at all */
+	auto start = std::chrono::steady_clock::now();
+	applySamplePlan(SamplePlan(getCachedSamplePlan(*plotGroupHandler->getActiveGroup())));
+	updateProbeSampleList();
+	logger->info("Sample list rebuilt after a pointer chain change in {} us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+bool ViewerDataHandler::havePointersChanged(const SamplePlan& plan, const std::vector<uint32_t>& values) const
+{
+	for (auto slot : plan.rootPointerSlots)
 	{
-		variable->setIsCurrentlySampled(false);
-		if (std::find(sampleList.begin(), sampleList.end(), std::pair<uint32_t, uint8_t>(variable->getAddress(), variable->getSize())) != sampleList.end())
-			variable->setIsCurrentlySampled(true);
+		if (slot >= values.size())
+			continue;
+
+		auto pointer = rootPointerValues.find(plan.sampleList[slot].first);
+		if (pointer != rootPointerValues.end() && values[slot] != pointer->second)
+			return true;
+	}
+	return false;
+}
+
+bool ViewerDataHandler::havePointersChanged(const RawFrame& frame) const
+{
+	for (auto slot : frame.plan->rootPointerSlots)
+	{
+		if (slot >= frame.values.size() || !frame.isValid[slot])
+			continue;
+
+		auto pointer = rootPointerValues.find(frame.plan->sampleList[slot].first);
+		if (pointer != rootPointerValues.end() && frame.values[slot] != pointer->second)
+			return true;
 	}
+	return false;
+}
+
+bool ViewerDataHandler::enableCycleCounter()
+{
+	uint32_t demcr = 0;
+	if (!debugProbe->readMemory(CycleCounter::demcrAddress, (uint8_t*)&demcr, 4))
+		return false;
+
+	demcr |= CycleCounter::demcrTrcena;
+	if (!debugProbe->writeMemory(CycleCounter::demcrAddress, (uint8_t*)&demcr, 4))
+		return false;
+
+	uint32_t dwtCtrl = 0;
+	if (!debugProbe->readMemory(CycleCounter::dwtCtrlAddress, (uint8_t*)&dwtCtrl, 4))
+		return false;
+
+	dwtCtrl |= CycleCounter::dwtCtrlCyccntena;
+	return debugProbe->writeMemory(CycleCounter::dwtCtrlAddress, (uint8_t*)&dwtCtrl, 4);
 }
 
 void ViewerDataHandler::prepareCSVFile()
@@ -247,4 +1499,5 @@ void ViewerDataHandler::prepareCSVFile()
 	}
 	csvStreamer->prepareFile(settings.logFilePath);
 	csvStreamer->createHeader(headerNames);
+	logHeader = headerNames;
 }
\ No newline at end of file
@@ -1,16 +1,28 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
+#include "CycleCounter.hpp"
 #include "DataHandlerBase.hpp"
 #include "IDebugProbe.hpp"
 #include "MovingAverage.hpp"
+#include "RingBufferLockFree.hpp"
+#include "RttReader.hpp"
+#include "SamplingPlanner.hpp"
+#include "StimulusGenerator.hpp"
+#include "ThreadPriority.hpp"
 #include "VariableHandler.hpp"
+#include "VariableTrigger.hpp"
+#include "WatchEngine.hpp"
 
 class ViewerDataHandler : public DataHandlerBase
 {
@@ -28,18 +40,72 @@ class ViewerDataHandler : public DataHandlerBase
 		bool shouldLog = false;
 		std::string logFilePath = "";
 		std::string gdbCommand = "gdb";
+		bool useTargetTimestamps = false;
+		uint32_t coreFrequency = 160000;
+		VariableTrigger::Settings trigger{};
+		StimulusGenerator::Settings stimulus{};
+		RttReader::Settings rtt{};
+		bool burstMode = false;
+		uint32_t burstSamples = 10000;
+		/* 0 means the burst is limited by the number of samples only */
+		double burstTimeS = 0.0;
+		/* how often pointer chains are resolved again, 0 means only at start and when a root pointer changes */
+		uint32_t pointerRefreshFrequencyHz = 1;
+		ThreadPriority::Settings threadPriority{};
 	} Settings;
 
+	typedef struct StimulusStatistics
+	{
+		uint64_t writes = 0;
+		/* writes skipped because the acquisition loop was late by more than a write period */
+		uint64_t missedWrites = 0;
+		uint64_t failedWrites = 0;
+		double meanLatenessUs = 0.0;
+		double maxLatenessUs = 0.0;
+	} StimulusStatistics;
+
+	typedef struct RttStatistics
+	{
+		bool isAttached = false;
+		uint32_t controlBlockAddress = 0;
+		uint64_t bytesRead = 0;
+		uint64_t records = 0;
+		std::string lastErrorMsg = "";
+	} RttStatistics;
+
+	/* counters of a queue between two acquisition pipeline stages */
+	typedef struct StageStatistics
+	{
+		size_t depth = 0;
+		size_t maxDepth = 0;
+		size_t capacity = 0;
+		uint64_t frames = 0;
+		/* frames the producing stage could not hand over because the queue was full */
+		uint64_t dropped = 0;
+	} StageStatistics;
+
+	/* the probe stage only reads and timestamps raw frames, the processing stage converts and publishes them
+	   to the plots and the logging stage writes the converted frames to the log file */
+	typedef struct PipelineStatistics
+	{
+		StageStatistics processing{};
+		StageStatistics logging{};
+	} PipelineStatistics;
+
 	ViewerDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger);
 	virtual ~ViewerDataHandler();
 
 	std::string getLastReaderError() const;
-	bool writeSeriesValue(Variable& var, double value);
+	void disconnectProbe() override;
+	/* the write is queued and executed by the acquisition thread between samples, returns false if the queue is full */
+	bool writeSeriesValue(Variable& var, double value, std::function<void(bool)> onComplete = nullptr);
 
 	IDebugProbe::DebugProbeSettings getProbeSettings() const;
 	void setProbeSettings(const IDebugProbe::DebugProbeSettings& settings);
 
 	void setDebugProbe(std::shared_ptr<IDebugProbe> probe);
+	/* nullptr until a probe is set */
+	ProbeStatistics* getProbeStatistics() const;
 
 	Settings getSettings() const;
 	void setSettings(const Settings& newSettings);
@@ -51,16 +117,211 @@ class ViewerDataHandler : public DataHandlerBase
 		return 0.0;
 	}
 
+	StimulusStatistics getStimulusStatistics() const;
+	RttStatistics getRttStatistics() const;
+
+	/* _SEGGER_RTT address from the ELF file, 0 makes the control block to be searched for in the RAM */
+	void setRttControlBlockAddress(uint32_t address) { rttControlBlockAddress = address; }
+
+	/* how late the acquisition ticks start compared to their schedule, NORMAL mode only */
+	double getMeanSchedulingLatencyUs() const { return meanSchedulingLatencyUs; }
+	double getMaxSchedulingLatencyUs() const { return maxSchedulingLatencyUs; }
+
+	PipelineStatistics getPipelineStatistics() const;
+
+	/* prediction for the active group with the current probe settings, calibrated with the latencies of previous acquisitions */
+	SamplingPlanner::Estimate getSamplingEstimate();
+	bool isSamplingEstimateCalibrated() const;
+
+	/* watches are compiled on every start, changes made during the acquisition are applied on the next one */
+	WatchEngine& getWatchEngine() { return watchEngine; }
+
+	/* rebuilds the sample list if the active group or its contents changed and swaps it into the running acquisition */
+	void refreshSampleList();
+
+	/* number of acquisition ticks between two consecutive samples of a plot sampled at plotFrequencyHz */
+	static uint32_t calculateSampleDivider(uint32_t baseFrequencyHz, uint32_t plotFrequencyHz)
+	{
+		if (plotFrequencyHz == 0 || plotFrequencyHz >= baseFrequencyHz)
+			return 1;
+		return std::max(1u, static_cast<uint32_t>(std::lround(static_cast<double>(baseFrequencyHz) / plotFrequencyHz)));
+	}
+
    private:
 	using SampleListType = std::vector<std::pair<uint32_t, uint8_t>>;
 
-	void updateVariables(double timestamp, const std::unordered_map<uint32_t, double>& values);
+	/* group of plots sampled every divider-th acquisition tick, phase is used to interleave reads of different classes */
+	struct RateClass
+	{
+		uint32_t divider = 1;
+		uint32_t phase = 0;
+
+		bool isDue(uint32_t tick) const { return ((tick + phase) % divider) == 0; }
+	};
+
+	/* array series read with a single block transfer and published as a snapshot */
+	struct ArrayRead
+	{
+		std::shared_ptr<Plot> plot;
+		std::string seriesName;
+		/* copy of the series variable used to convert the raw elements */
+		Variable element;
+		uint32_t address;
+		uint32_t length;
+		uint32_t rateClassMask;
+	};
+
+	/* everything the acquisition loop needs to sample a single plot group */
+	struct SamplePlan
+	{
+		SampleListType sampleList;
+		/* bitmask of rate classes that require the sample list entry of the same index */
+		std::vector<uint32_t> sampleRateClasses;
+		std::vector<RateClass> rateClasses;
+		std::unordered_map<const Plot*, size_t> plotRateClass;
+		std::vector<ArrayRead> arrayReads;
+		/* sampled variables sorted so that fractional bases are evaluated first */
+		std::vector<Variable*> evaluationOrder;
+		/* sample list position of every evaluationOrder entry, -1 if it is not sampled */
+		std::vector<int32_t> evaluationSlots;
+		std::shared_ptr<Variable> triggerVariable;
+		int32_t triggerSlot = -1;
+		/* sample list positions of the root pointers of the sampled pointer chains */
+		std::vector<uint32_t> rootPointerSlots;
+		size_t signature = 0;
+	};
+
+	struct WriteRequest
+	{
+		uint32_t address;
+		uint32_t value;
+		uint8_t size;
+		std::function<void(bool)> onComplete;
+	};
+
+	/* single acquisition tick handed from the probe stage to the processing stage */
+	struct RawFrame
+	{
+		double timestamp;
+		uint32_t dueRateClasses;
+		/* plan the frame was sampled with, it stays valid when a new plan is swapped in meanwhile */
+		std::shared_ptr<SamplePlan> plan;
+		/* raw values in sample list order, only entries marked in isValid were read in this tick */
+		std::vector<uint32_t> values;
+		std::vector<uint8_t> isValid;
+		/* array snapshots in arrayReads order, each at arrayOffsets of the same index */
+		std::vector<uint8_t> arrayData;
+		std::vector<uint32_t> arrayOffsets;
+		std::vector<uint8_t> isArrayValid;
+		/* RTT records drained in this tick, applied before the sampled values */
+		std::vector<RttRecordDecoder::Record> rttRecords;
+	};
+
+	/* converted tick handed from the processing stage to the logging stage, values in the log header order */
+	struct LogFrame
+	{
+		double timestamp;
+		std::vector<double> values;
+	};
+
+	/* queue between two pipeline stages with counters readable from other threads */
+	template <typename T, size_t capacity>
+	struct StageQueue
+	{
+		RingBufferLockFree<T, capacity> queue;
+		std::atomic<size_t> maxDepth = 0;
+		std::atomic<uint64_t> frames = 0;
+		std::atomic<uint64_t> dropped = 0;
+
+		void reset()
+		{
+			while (queue.front() != nullptr)
+				queue.popFront();
+			maxDepth = 0;
+			frames = 0;
+			dropped = 0;
+		}
+
+		StageStatistics getStatistics() const
+		{
+			return {queue.size(), maxDepth, capacity, frames, dropped};
+		}
+	};
+
+	/* single acquisition tick kept in the pre-trigger history, values are in the sample list order of plan */
+	struct Frame
+	{
+		double timestamp;
+		std::shared_ptr<SamplePlan> plan;
+		std::vector<uint32_t> values;
+		std::vector<uint8_t> isValid;
+		uint32_t dueRateClasses;
+	};
+
+	enum class TriggerState
+	{
+		ARMED = 0,
+		TRIGGERED = 1,
+	};
+
+	/* values and isValid are in the sample list order of processingPlan */
+	void updateVariables(double timestamp, const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid, uint32_t dueRateClasses);
+	void evaluateVariables(const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid);
+	void compileWatches();
+	void processWatches(double timestamp);
+	void updatePlots(double timestamp, uint32_t dueRateClasses);
+	void handleTrigger(double timestamp, const std::vector<uint32_t>& values, const std::vector<uint8_t>& isValid, uint32_t dueRateClasses);
+	void armTrigger();
+	bool readFrame(RawFrame& frame, uint32_t dueRateClasses);
+	bool readArrays(RawFrame& frame, uint32_t dueRateClasses);
+	void pushFrame(const IDebugProbe::Frame& entry, double timestamp, uint32_t dueRateClasses);
+	void publishArrays(RawFrame& frame);
+	void startPipeline();
+	void stopPipeline();
+	void haltPipeline();
+	void processingStage();
+	void processFrame(RawFrame& frame);
+	void loggingStage();
+	void logFrame(double timestamp);
+	void processWriteRequests();
+	void cancelWriteRequests();
+	void captureBurst(std::chrono::time_point<std::chrono::steady_clock> start);
+	void prepareStimulus();
+	void handleStimulus(double t);
+	void prepareRtt();
+	void readRtt(RawFrame& frame);
+	void applyRttRecords(const RawFrame& frame);
+	/* names bound to the RTT channels in the channel order, empty when RTT is disabled */
+	std::vector<std::string> getRttChannelNames() const;
 	void dataHandler();
 	void prepareCSVFile();
 	void createSampleList();
+	SamplePlan createSamplePlan(PlotGroup& group);
+	/* returns the cached plan of the group, rebuilt when its signature changed, acquisition thread only */
+	const SamplePlan& getCachedSamplePlan(PlotGroup& group);
+	size_t getSamplePlanSignature(PlotGroup& group) const;
+	void applySamplePlan(SamplePlan&& plan);
+	void swapPendingSamplePlan();
+	size_t getRateClass(SamplePlan& plan, uint32_t divider);
+	uint32_t getDueRateClasses(uint32_t tick) const;
+	bool enableCycleCounter();
+	bool resolvePointerChains();
+	void refreshPointerChains();
+	void updateProbeSampleList();
+	bool havePointersChanged(const SamplePlan& plan, const std::vector<uint32_t>& values) const;
+	bool havePointersChanged(const RawFrame& frame) const;
 
    private:
 	static constexpr size_t maxVariablesOnSinglePlot = 100;
+	static constexpr size_t maxRateClasses = 32;
+	static constexpr uint32_t allRateClasses = 0xffffffff;
+	static constexpr size_t maxPendingWrites = 64;
+	static constexpr uint32_t maxWriteTransactionSize = 64;
+	static constexpr uint32_t maxArraySize = 16384;
+	static constexpr size_t processingQueueSize = 1024;
+	static constexpr size_t loggingQueueSize = 1024;
+	static constexpr uint32_t stageIdleSleepUs = 200;
+	static constexpr size_t maxHssFramesPerRead = 256;
 	std::shared_ptr<IDebugProbe> debugProbe;
 	IDebugProbe::DebugProbeSettings probeSettings{};
 	MovingAverage samplingPeriodFilter{1000};
@@ -68,5 +329,85 @@ class ViewerDataHandler : public DataHandlerBase
 	Settings settings{};
 	std::unordered_map<std::string, double> csvEntry;
 
-	SampleListType sampleList;
+	/* used by the probe stage, the processing stage uses the plan of the processed frame */
+	std::shared_ptr<SamplePlan> samplePlan = std::make_shared<SamplePlan>();
+	std::shared_ptr<SamplePlan> processingPlan = samplePlan;
+	/* plans of all groups computed at start, keyed by group name, written on the acquisition thread under samplePlanMtx */
+	std::unordered_map<std::string, SamplePlan> samplePlanCache;
+	std::atomic<bool> isSamplePlanPending = false;
+	std::mutex samplePlanMtx;
+	/* the last plan request posted by the GUI thread */
+	std::string requestedSamplePlanGroup;
+	size_t requestedSamplePlanSignature = 0;
+	CycleCounter cycleCounter;
+
+	MovingAverage schedulingLatencyFilter{1000};
+	std::atomic<double> meanSchedulingLatencyUs = 0.0;
+	std::atomic<double> maxSchedulingLatencyUs = 0.0;
+
+	/* preallocated so that array conversion does not allocate in the processing stage */
+	std::vector<double> arrayFrame;
+
+	std::unique_ptr<StageQueue<RawFrame, processingQueueSize>> rawFrames = std::make_unique<StageQueue<RawFrame, processingQueueSize>>();
+	/* HSS ticks decoded by the probe, reused between reads */
+	std::vector<IDebugProbe::Frame> hssFrames = std::vector<IDebugProbe::Frame>(maxHssFramesPerRead);
+	/* read into when the processing queue is full */
+	RawFrame droppedFrame{};
+	std::unique_ptr<StageQueue<LogFrame, loggingQueueSize>> logFrames = std::make_unique<StageQueue<LogFrame, loggingQueueSize>>();
+	std::thread processingHandle;
+	std::thread loggingHandle;
+	std::atomic<bool> isPipelineRunning = false;
+	std::atomic<bool> isLoggingRunning = false;
+	/* set when the processing stage stops the acquisition (trigger or watch), the frames still queued are discarded */
+	std::atomic<bool> isPipelineHalted = false;
+	/* set while a finished burst capture is evaluated, logFrame waits for room instead of dropping */
+	std::atomic<bool> isBurstReplay = false;
+	/* set while a burst capture is published with the plot lock already taken by the acquisition thread */
+	bool isPlotLockHeld = false;
+	/* names of the logged series, fixed at start */
+	std::vector<std::string> logHeader;
+	/* entries due in the current tick, reused by readFrame */
+	std::vector<std::pair<uint32_t, uint8_t>> dueReads;
+	std::vector<size_t> dueIndices;
+	std::vector<uint32_t> dueValues;
+
+	/* last known values of the root pointers of pointer chain variables */
+	std::unordered_map<uint32_t, uint32_t> rootPointerValues;
+	double pointerRefreshTime = 0.0;
+
+	SamplingPlanner samplingPlanner{};
+	size_t samplingEstimateSignature = 0;
+	SamplingPlanner::Estimate samplingEstimate{};
+
+	VariableTrigger trigger{};
+	TriggerState triggerState = TriggerState::ARMED;
+	/* ring of the last preTriggerPoints ticks sized when the trigger is armed, the slots are overwritten in place */
+	std::vector<Frame> preTriggerFrames;
+	size_t preTriggerHead = 0;
+	size_t preTriggerCount = 0;
+	uint32_t postTriggerCnt = 0;
+
+	RingBufferLockFree<WriteRequest, maxPendingWrites> writeQueue;
+
+	WatchEngine watchEngine{};
+	/* variables bound to the watch slots and their values in the current sample */
+	std::vector<Variable*> watchVariables;
+	std::vector<double> watchValues;
+
+	StimulusGenerator stimulusGenerator{};
+	std::shared_ptr<Variable> stimulusVariable;
+	uint64_t stimulusTick = 0;
+	StimulusStatistics stimulusStatistics{};
+	mutable std::mutex stimulusMtx;
+
+	std::unique_ptr<RttReader> rttReader;
+	RttRecordDecoder rttDecoder{};
+	/* drained bytes, reused between reads */
+	std::vector<uint8_t> rttData;
+	/* variables bound to the RTT channels, resolved at start */
+	std::vector<Variable*> rttChannels;
+	double rttReadTime = 0.0;
+	std::atomic<uint32_t> rttControlBlockAddress = 0;
+	RttStatistics rttStatistics{};
+	mutable std::mutex rttMtx;
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef __FRAMEBUFFER_HPP
+#define __FRAMEBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/* Keeps the most recent snapshots of an array variable.
+   Older frames are used for the persistence effect, the running average is computed over the last averaging frames. */
+template <typename T>
+class FrameBuffer
+{
+   public:
+	FrameBuffer() = default;
+	~FrameBuffer() = default;
+
+	void addFrame(const std::vector<T>& frame)
+	{
+		if (frame.size() != sum.size())
+		{
+			count = 0;
+			sum.assign(frame.size(), T{});
+		}
+
+		/* the oldest averaged frame leaves the window before its slot can be reused */
+		if (count >= averaging)
+			for (size_t i = 0; i < sum.size(); i++)
+				sum[i] -= getFrame(averaging - 1)[i];
+
+		/* the storage of the oldest frame is reused, a slot is only added while the buffer grows to its capacity */
+		if (count == frames.size() && frames.size() < getCapacity())
+			frames.insert(frames.begin() + head, std::vector<T>{});
+		else
+			head = (head + frames.size() - 1) % frames.size();
+
+		frames[head].assign(frame.begin(), frame.end());
+		count = std::min(count + 1, frames.size());
+
+		for (size_t i = 0; i < frame.size(); i++)
+			sum[i] += frame[i];
+
+		updateAverage();
+	}
+
+	/* age 0 is the newest frame */
+	const std::vector<T>& getFrame(size_t age) const { return frames.at((head + age) % frames.size()); }
+
+	/* number of frames available for display with the current persistence */
+	size_t getFrameCount() const { return std::min(count, persistence); }
+
+	const std::vector<T>& getAverage() const { return average; }
+
+	size_t getFrameSize() const { return sum.size(); }
+
+	void setPersistence(size_t newPersistence)
+	{
+		persistence = std::max<size_t>(1, newPersistence);
+		trim();
+	}
+	size_t getPersistence() const { return persistence; }
+
+	void setAveraging(size_t newAveraging)
+	{
+		averaging = std::max<size_t>(1, newAveraging);
+		trim();
+	}
+	size_t getAveraging() const { return averaging; }
+
+	/* the frame storage is kept for the next capture */
+	void erase()
+	{
+		head = 0;
+		count = 0;
+		sum.clear();
+		average.clear();
+	}
+
+   private:
+	size_t getCapacity() const { return std::max(persistence, averaging); }
+
+	void trim()
+	{
+		/* the ring is rebuilt newest first with the frames that still fit */
+		std::vector<std::vector<T>> ordered;
+		for (size_t age = 0; age < std::min(count, getCapacity()); age++)
+			ordered.push_back(std::move(frames[(head + age) % frames.size()]));
+		frames = std::move(ordered);
+		head = 0;
+		count = frames.size();
+
+		/* the window changed so the sum is computed from scratch */
+		std::fill(sum.begin(), sum.end(), T{});
+		for (size_t i = 0; i < std::min(count, averaging); i++)
+			for (size_t j = 0; j < sum.size(); j++)
+				sum[j] += getFrame(i)[j];
+
+		updateAverage();
+	}
+
+	void updateAverage()
+	{
+		average.resize(sum.size());
+		const size_t averaged = std::min(count, averaging);
+		for (size_t i = 0; i < sum.size(); i++)
+			average[i] = averaged > 0 ? sum[i] / static_cast<T>(averaged) : T{};
+	}
+
+	/* ring of frame storage, the newest frame is at head and older ones follow */
+	std::vector<std::vector<T>> frames;
+	size_t head = 0;
+	size_t count = 0;
+	std::vector<T> sum;
+	std::vector<T> average;
+	size_t persistence = 1;
+	size_t averaging = 1;
+};
+
+#endif
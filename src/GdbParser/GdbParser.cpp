@@ -57,6 +57,26 @@ bool GdbParser::updateVariableMap(const std::string& elfPath)
 		var->setType(checkType(var->getTrackedName(), nullptr));
 	}
 
+	rttControlBlockAddress = checkAddress(rttControlBlockSymbol);
+
+	process.closePipes();
+
+	return true;
+}
+
+bool GdbParser::updateRttControlBlockAddress(const std::string& elfPath)
+{
+	rttControlBlockAddress = std::nullopt;
+
+	if (!validateGDB())
+		return false;
+
+	if (!std::filesystem::exists(elfPath))
+		return false;
+
+	std::string cmd = currentGDBCommand + std::string(" --interpreter=mi ") + elfPath;
+	process.executeCmd(cmd, "(gdb)");
+	rttControlBlockAddress = checkAddress(rttControlBlockSymbol);
 	process.closePipes();
 
 	return true;
@@ -268,4 +288,9 @@ std::map<std::string, GdbParser::VariableData> GdbParser::getParsedData()
 {
 	std::lock_guard<std::mutex> lock(mtx);
 	return parsedData;
+}
+
+std::optional<uint32_t> GdbParser::getRttControlBlockAddress() const
+{
+	return rttControlBlockAddress;
 }
\ No newline at end of file
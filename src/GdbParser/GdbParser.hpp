@@ -34,7 +34,11 @@ class GdbParser
 	bool validateGDB();
 	bool updateVariableMap(const std::string& elfPath);
 	bool parse(const std::string& elfPath);
+	/* looks up only the RTT control block, for a new or rebuilt *.elf file without a variable update */
+	bool updateRttControlBlockAddress(const std::string& elfPath);
 	std::map<std::string, VariableData> getParsedData();
+	/* address of the SEGGER RTT control block found by the last updateVariableMap or updateRttControlBlockAddress */
+	std::optional<uint32_t> getRttControlBlockAddress() const;
 
 	void changeCurrentGDBCommand(const std::string& command);
 
@@ -46,11 +50,13 @@ class GdbParser
 
    private:
 	const char* defaultGDBCommand = "gdb";
+	static constexpr const char* rttControlBlockSymbol = "_SEGGER_RTT";
 	std::string currentGDBCommand = std::string(defaultGDBCommand);
 	VariableHandler* variableHandler;
 	spdlog::logger* logger;
 	std::mutex mtx;
 	std::map<std::string, VariableData> parsedData;
+	std::optional<uint32_t> rttControlBlockAddress;
 	ProcessHandler process;
 
 	std::unordered_map<std::string, Variable::Type> isTrivial = {
@@ -13,8 +13,11 @@
 #include "ConfigHandler.hpp"
 #include "GuiPlotEdit.hpp"
 #include "GuiPlotsTree.hpp"
+#include "GuiProbeDiagnostics.hpp"
 #include "GuiVarTable.hpp"
 #include "GuiVariablesEdit.hpp"
+#include "GdbRemoteDebugProbe.hpp"
+#include "GuiWatchWindow.hpp"
 #include "IDebugProbe.hpp"
 #include "IFileHandler.hpp"
 #include "ImguiPlugins.hpp"
@@ -23,7 +26,10 @@
 #include "Plot.hpp"
 #include "PlotGroupHandler.hpp"
 #include "Popup.hpp"
+#include "ProbeDiscovery.hpp"
+#include "SimulatedDebugProbe.hpp"
 #include "TraceDataHandler.hpp"
+#include "UsbHotplugMonitor.hpp"
 #include "VariableHandler.hpp"
 #include "ViewerDataHandler.hpp"
 #include "imgui.h"
@@ -52,6 +58,8 @@ class Gui
 	bool showAboutWindow = false;
 	bool showPreferencesWindow = false;
 	bool showSelectVariablesWindow = false;
+	bool showWatchWindow = false;
+	bool showProbeDiagnosticsWindow = false;
 
 	IFileHandler* fileHandler;
 	PlotHandler* tracePlotHandler;
@@ -60,6 +68,8 @@ class Gui
 
 	std::shared_ptr<IDebugProbe> stlinkProbe;
 	std::shared_ptr<IDebugProbe> jlinkProbe;
+	std::shared_ptr<SimulatedDebugProbe> simulatedProbe;
+	std::shared_ptr<IDebugProbe> gdbRemoteProbe;
 	std::shared_ptr<IDebugProbe> debugProbeDevice;
 	std::vector<std::string> devicesList{};
 	const std::string noDevices = "No debug probes found!";
@@ -68,6 +78,14 @@ class Gui
 	std::shared_ptr<ITraceProbe> jlinkTraceProbe;
 	std::shared_ptr<ITraceProbe> traceProbeDevice;
 
+	/* USB probes are listed from the discovery cache, devicesChanged is set on every discovery event */
+	std::unique_ptr<ProbeDiscovery> probeDiscovery;
+	std::unique_ptr<UsbHotplugMonitor> usbHotplugMonitor;
+	bool devicesChanged = false;
+	static constexpr std::chrono::milliseconds discoveryPollPeriod{2000};
+	/* with hotplug notifications polling is only a safety net */
+	static constexpr std::chrono::milliseconds discoveryHotplugPollPeriod{30000};
+
 	std::atomic<bool>& done;
 
 	Popup popup;
@@ -88,6 +106,8 @@ class Gui
 	std::shared_ptr<PlotEditWindow> plotEditWindow;
 	std::shared_ptr<VariableTableWindow> variableTable;
 	std::shared_ptr<PlotsTree> plotsTree;
+	std::shared_ptr<WatchWindow> watchWindow;
+	std::shared_ptr<ProbeDiagnosticsWindow> probeDiagnosticsWindow;
 
    private:
 	void mainThread(std::string externalPath);
@@ -95,6 +115,11 @@ class Gui
 	void drawStartButton(DataHandlerBase* activeDataHandler);
 	void drawDebugProbes();
 	void drawTraceProbes();
+	void startProbeDiscovery();
+	/* nullptr for the probe types that are listed directly */
+	static const char* getDiscoverySource(uint32_t debugProbe);
+	/* keeps the selected serial number when it is still listed, returns true when it was changed */
+	bool selectDevice(std::string& serialNumber, int& SNptr, bool pickFirst);
 	void drawUpdateAddressesFromElf();
 	void drawAcqusitionSettingsWindow(ActiveViewType type);
 	void acqusitionSettingsViewer();
@@ -102,6 +127,9 @@ class Gui
 	template <typename Settings>
 	void drawLoggingSettings(PlotHandler* handler, Settings& settings);
 	void drawGdbSettings(ViewerDataHandler::Settings& settings);
+	void drawTriggerSettings(ViewerDataHandler::Settings& settings);
+	void drawStimulusSettings(ViewerDataHandler::Settings& settings);
+	void drawRttSettings(ViewerDataHandler::Settings& settings);
 
 	void drawAboutWindow();
 	void drawPreferencesWindow();
@@ -112,6 +140,9 @@ class Gui
 	void drawPlotBar(std::shared_ptr<Plot> plot);
 	void drawPlotTable(std::shared_ptr<Plot> plot);
 	void drawPlotXY(std::shared_ptr<Plot> plot);
+	void drawPlotArray(std::shared_ptr<Plot> plot);
+	void drawDecimatedHistory(std::shared_ptr<Plot> plot);
+	void drawThreadPrioritySettings(ThreadPriority::Settings& settings);
 	void handleMarkers(uint32_t id, Plot::Marker& marker, ImPlotRect plotLimits, std::function<void()> activeCallback);
 	void handleDragRect(uint32_t id, Plot::DragRect& dragRect, ImPlotRect plotLimits);
 	void dragAndDropPlot(std::shared_ptr<Plot> plot);
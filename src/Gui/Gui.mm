@@ -3,6 +3,7 @@
 #include <imgui.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <future>
 #include <set>
 #include <sstream>
@@ -23,9 +24,11 @@
 Gui::Gui(PlotHandler* plotHandler, VariableHandler* variableHandler, ConfigHandler* configHandler, PlotGroupHandler* plotGroupHandler, IFileHandler* fileHandler, PlotHandler* tracePlotHandler, ViewerDataHandler* viewerDataHandler, TraceDataHandler* traceDataHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger, std::string& projectPath) : plotHandler(plotHandler), variableHandler(variableHandler), configHandler(configHandler), plotGroupHandler(plotGroupHandler), fileHandler(fileHandler), tracePlotHandler(tracePlotHandler), viewerDataHandler(viewerDataHandler), traceDataHandler(traceDataHandler), done(done), mtx(mtx), logger(logger)
 {
 	threadHandle = std::thread(&Gui::mainThread, this, projectPath);
-	plotEditWindow = std::make_shared<PlotEditWindow>(plotHandler, plotGroupHandler, variableHandler);
+	plotEditWindow = std::make_shared<PlotEditWindow>(plotHandler, plotGroupHandler, variableHandler, mtx);
 	plotsTree = std::make_shared<PlotsTree>(viewerDataHandler, plotHandler, plotGroupHandler, variableHandler, plotEditWindow, fileHandler, logger);
 	variableTable = std::make_shared<VariableTableWindow>(viewerDataHandler, plotHandler, variableHandler, &projectElfPath, &projectConfigPath, logger);
+	watchWindow = std::make_shared<WatchWindow>(viewerDataHandler, traceDataHandler);
+	probeDiagnosticsWindow = std::make_shared<ProbeDiagnosticsWindow>(viewerDataHandler, traceDataHandler, fileHandler, logger);
 
 	variableHandler->renameCallback = [&](std::string oldName, std::string newName)
 	{
@@ -98,6 +101,8 @@ void Gui::mainThread(std::string externalPath)
 
 	jlinkProbe = std::make_shared<JlinkDebugProbe>(logger);
 	stlinkProbe = std::make_shared<StlinkDebugProbe>(logger);
+	simulatedProbe = std::make_shared<SimulatedDebugProbe>(logger);
+	gdbRemoteProbe = std::make_shared<GdbRemoteDebugProbe>(logger);
 	debugProbeDevice = stlinkProbe;
 	viewerDataHandler->setDebugProbe(debugProbeDevice);
 
@@ -106,6 +111,8 @@ void Gui::mainThread(std::string externalPath)
 	traceProbeDevice = stlinkTraceProbe;
 	traceDataHandler->setDebugProbe(traceProbeDevice);
 
+	startProbeDiscovery();
+
 	if (!externalPath.empty())
 		openProject(externalPath);
 
@@ -123,6 +130,11 @@ void Gui::mainThread(std::string externalPath)
 			glfwSwapInterval(4);
 
 		glfwSetWindowTitle(window, (std::string("MCUViewer - ") + projectConfigPath).c_str());
+
+		ProbeDiscovery::Event event;
+		while (probeDiscovery->popEvent(event))
+			devicesChanged = true;
+
 		glfwPollEvents();
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
@@ -149,6 +161,8 @@ void Gui::mainThread(std::string externalPath)
 		drawMenu();
 		drawAboutWindow();
 		drawPreferencesWindow();
+		watchWindow->draw(showWatchWindow);
+		probeDiagnosticsWindow->draw(showProbeDiagnosticsWindow);
 
 		if (ImGui::Begin("Trace Viewer"))
 		{
@@ -180,6 +194,10 @@ void Gui::mainThread(std::string externalPath)
 		}
 		ImGui::End();
 
+		/* group or visibility changes are picked up by the running acquisition */
+		if (viewerDataHandler->getState() == DataHandlerBase::State::RUN)
+			viewerDataHandler->refreshSampleList();
+
 		popup.handle();
 
 		// Rendering
@@ -202,6 +220,9 @@ void Gui::mainThread(std::string externalPath)
 
 	logger->info("Exiting GUI main thread");
 
+	usbHotplugMonitor->stop();
+	probeDiscovery->stop();
+
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();
@@ -211,6 +232,50 @@ void Gui::mainThread(std::string externalPath)
 	fileHandler->deinit();
 }
 
+void Gui::startProbeDiscovery()
+{
+	probeDiscovery = std::make_unique<ProbeDiscovery>(logger);
+
+	/* the USB probes are not enumerated while an acquisition may be using them */
+	auto isIdle = [this]()
+	{ return viewerDataHandler->getState() != DataHandlerBase::State::RUN && traceDataHandler->getState() != DataHandlerBase::State::RUN; };
+
+	probeDiscovery->addSource("STLINK", [this, isIdle]() -> std::optional<std::vector<std::string>>
+							  { return isIdle() ? std::optional(stlinkProbe->getConnectedDevices()) : std::nullopt; });
+	probeDiscovery->addSource("JLINK", [this, isIdle]() -> std::optional<std::vector<std::string>>
+							  { return isIdle() ? std::optional(jlinkProbe->getConnectedDevices()) : std::nullopt; });
+
+	usbHotplugMonitor = std::make_unique<UsbHotplugMonitor>(probeDiscovery.get(), logger);
+	probeDiscovery->start(usbHotplugMonitor->start() ? discoveryHotplugPollPeriod : discoveryPollPeriod);
+}
+
+const char* Gui::getDiscoverySource(uint32_t debugProbe)
+{
+	if (debugProbe == 0)
+		return "STLINK";
+	else if (debugProbe == 1)
+		return "JLINK";
+	return nullptr;
+}
+
+bool Gui::selectDevice(std::string& serialNumber, int& SNptr, bool pickFirst)
+{
+	auto it = std::find(devicesList.begin(), devicesList.end(), serialNumber);
+	if (it != devicesList.end())
+	{
+		SNptr = static_cast<int>(it - devicesList.begin());
+		return false;
+	}
+
+	/* a probe held by a kept session can be missing from the list, so the selection only follows user actions */
+	if (!pickFirst || devicesList.empty())
+		return false;
+
+	serialNumber = devicesList[0];
+	SNptr = 0;
+	return true;
+}
+
 void Gui::drawMenu()
 {
 	bool shouldSaveOnClose = false;
@@ -246,6 +311,8 @@ void Gui::drawMenu()
 	if (ImGui::BeginMenu("Window"))
 	{
 		ImGui::MenuItem("Preferences", NULL, &showPreferencesWindow, active);
+		ImGui::MenuItem("Watches", NULL, &showWatchWindow);
+		ImGui::MenuItem("Probe diagnostics", NULL, &showProbeDiagnosticsWindow);
 		ImGui::EndMenu();
 	}
 	if (ImGui::BeginMenu("Help"))
@@ -303,6 +370,11 @@ void Gui::drawStartButton(DataHandlerBase* activeDataHandler)
 			logger->info("Start clicked!");
 			plotHandler->eraseAllPlotData();
 			tracePlotHandler->eraseAllPlotData();
+			/* both viewers may use the same device, the session kept open by the other one is released first */
+			if (activeDataHandler == viewerDataHandler)
+				traceDataHandler->disconnectProbe();
+			else
+				viewerDataHandler->disconnectProbe();
 			activeDataHandler->setState(DataHandlerBase::State::RUN);
 		}
 		else
@@ -461,6 +533,10 @@ bool Gui::openProject(std::string externalPath)
 		devicesList.clear();
 		if (viewerDataHandler->getProbeSettings().debugProbe == 1)
 			debugProbeDevice = jlinkProbe;
+		else if (viewerDataHandler->getProbeSettings().debugProbe == 2)
+			debugProbeDevice = simulatedProbe;
+		else if (viewerDataHandler->getProbeSettings().debugProbe == 3)
+			debugProbeDevice = gdbRemoteProbe;
 		else
 			debugProbeDevice = stlinkProbe;
 
@@ -32,6 +32,19 @@ void Gui::acqusitionSettingsViewer()
 	ImGui::HelpMarker("Maximum sampling frequency. Depending on the used debug probe it can be reached or not.");
 	settings.sampleFrequencyHz = std::clamp(settings.sampleFrequencyHz, ViewerDataHandler::minSamplinFrequencyHz, ViewerDataHandler::maxSamplinFrequencyHz);
 
+	auto estimate = viewerDataHandler->getSamplingEstimate();
+	GuiHelper::drawTextAlignedToSize("Estimated max [Hz]:", alignment);
+	ImGui::SameLine();
+	if (viewerDataHandler->getProbeSettings().mode == IDebugProbe::Mode::HSS)
+		ImGui::Text("%.0f", estimate.hssMaxFrequencyHz);
+	else
+		ImGui::Text("%.0f (as blocks: %.0f)", estimate.normalMaxFrequencyHz, estimate.coalescedMaxFrequencyHz);
+	ImGui::SameLine();
+	std::string estimateHelp = viewerDataHandler->isSamplingEstimateCalibrated() ? "Estimate calibrated with the latencies measured during the last acquisition." : "Estimate based on the default debug probe latency. It will be calibrated during the acquisition.";
+	for (auto& suggestion : estimate.suggestions)
+		estimateHelp += "\n- " + suggestion;
+	ImGui::HelpMarker(estimateHelp.c_str());
+
 	const uint32_t minPoints = 100;
 	const uint32_t maxPoints = 20000;
 	GuiHelper::drawTextAlignedToSize("Max points:", alignment);
@@ -48,8 +61,73 @@ void Gui::acqusitionSettingsViewer()
 	ImGui::HelpMarker("Max points used for a single series that will be shown in the viewport without scroling.");
 	settings.maxViewportPoints = std::clamp(settings.maxViewportPoints, minPoints, settings.maxPoints);
 
+	GuiHelper::drawTextAlignedToSize("Pointer refresh [Hz]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##pointerRefresh", ImGuiDataType_U32, &settings.pointerRefreshFrequencyHz, NULL, NULL, "%u");
+	ImGui::SameLine();
+	ImGui::HelpMarker("How often pointer chain variables are resolved again. Chains are also resolved whenever their root pointer changes. Set to 0 to disable the periodic refresh.");
+	settings.pointerRefreshFrequencyHz = std::min(settings.pointerRefreshFrequencyHz, settings.sampleFrequencyHz);
+
+	GuiHelper::drawTextAlignedToSize("Burst mode:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##burstMode", &settings.burstMode);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Reads the variables back-to-back as fast as the debug probe allows and shows the result after the capture is finished. NORMAL probe mode only.");
+
+	ImGui::BeginDisabled(!settings.burstMode);
+	GuiHelper::drawTextAlignedToSize("Burst samples:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##burstSamples", ImGuiDataType_U32, &settings.burstSamples, NULL, NULL, "%u");
+	settings.burstSamples = std::clamp(settings.burstSamples, minPoints, settings.maxPoints);
+
+	GuiHelper::drawTextAlignedToSize("Burst time [s]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputDouble("##burstTime", &settings.burstTimeS);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Maximum duration of the burst. Set to 0 to limit the burst by the number of samples only.");
+	settings.burstTimeS = std::max(settings.burstTimeS, 0.0);
+	ImGui::EndDisabled();
+
+	GuiHelper::drawTextAlignedToSize("Target timestamps:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##targetTimestamps", &settings.useTargetTimestamps);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Timestamps are taken from the DWT cycle counter read together with the variables instead of the host clock. Cortex-M3 and above only.");
+
+	ImGui::BeginDisabled(!settings.useTargetTimestamps);
+	GuiHelper::drawTextAlignedToSize("Core frequency [kHz]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##coreFrequency", ImGuiDataType_U32, &settings.coreFrequency, NULL, NULL, "%u");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Core clock frequency used to convert the cycle counter to seconds.");
+	ImGui::EndDisabled();
+
 	drawDebugProbes();
+	drawTriggerSettings(settings);
+	drawStimulusSettings(settings);
+	drawRttSettings(settings);
 	drawLoggingSettings(plotHandler, settings);
+	drawThreadPrioritySettings(settings.threadPriority);
+
+	GuiHelper::drawTextAlignedToSize("Scheduling latency [us]:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("mean %.1f, max %.1f", viewerDataHandler->getMeanSchedulingLatencyUs(), viewerDataHandler->getMaxSchedulingLatencyUs());
+	ImGui::SameLine();
+	ImGui::HelpMarker("How late the sampling ticks start compared to their schedule in the last acquisition. High maximum values are usually caused by the thread being preempted.");
+
+	auto pipeline = viewerDataHandler->getPipelineStatistics();
+	GuiHelper::drawTextAlignedToSize("Processing queue:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("%zu/%zu (max %zu), %llu frames, %llu dropped", pipeline.processing.depth, pipeline.processing.capacity, pipeline.processing.maxDepth, static_cast<unsigned long long>(pipeline.processing.frames), static_cast<unsigned long long>(pipeline.processing.dropped));
+	ImGui::SameLine();
+	ImGui::HelpMarker("Frames read by the probe thread waiting for conversion and publication to the plots. The probe thread never waits - frames are dropped when the queue is full.");
+
+	GuiHelper::drawTextAlignedToSize("Logging queue:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("%zu/%zu (max %zu), %llu frames, %llu dropped", pipeline.logging.depth, pipeline.logging.capacity, pipeline.logging.maxDepth, static_cast<unsigned long long>(pipeline.logging.frames), static_cast<unsigned long long>(pipeline.logging.dropped));
+	ImGui::SameLine();
+	ImGui::HelpMarker("Converted frames waiting to be written to the log file. Frames are dropped from the log when the queue is full.");
+
 	drawGdbSettings(settings);
 	viewerDataHandler->setSettings(settings);
 }
@@ -70,7 +148,7 @@ void Gui::drawDebugProbes()
 	GuiHelper::drawTextAlignedToSize("Debug probe:", alignment);
 	ImGui::SameLine();
 
-	const char* debugProbes[] = {"STLINK", "JLINK"};
+	const char* debugProbes[] = {"STLINK", "JLINK", "SIMULATED", "GDB SERVER"};
 	IDebugProbe::DebugProbeSettings probeSettings = viewerDataHandler->getProbeSettings();
 	int32_t debugProbe = probeSettings.debugProbe;
 
@@ -84,6 +162,16 @@ void Gui::drawDebugProbes()
 			debugProbeDevice = jlinkProbe;
 			shouldListDevices = true;
 		}
+		else if (probeSettings.debugProbe == 2)
+		{
+			debugProbeDevice = simulatedProbe;
+			shouldListDevices = true;
+		}
+		else if (probeSettings.debugProbe == 3)
+		{
+			debugProbeDevice = gdbRemoteProbe;
+			shouldListDevices = true;
+		}
 		else
 		{
 			debugProbeDevice = stlinkProbe;
@@ -102,15 +190,27 @@ void Gui::drawDebugProbes()
 
 	ImGui::SameLine();
 
-	if (ImGui::Button("@", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)) || shouldListDevices || devicesList.empty())
+	if (ImGui::Button("@", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)))
+		probeDiscovery->requestRescan();
+
+	if (shouldListDevices || devicesChanged || devicesList.empty())
 	{
-		devicesList = debugProbeDevice->getConnectedDevices();
-		if (!devicesList.empty())
-		{
-			probeSettings.serialNumber = devicesList[0];
-			modified = true;
-		}
+		const bool hadDevices = !devicesList.empty() && devicesList.front() != noDevices;
+		const char* source = getDiscoverySource(probeSettings.debugProbe);
+		devicesList = source != nullptr ? probeDiscovery->getDevices(source) : debugProbeDevice->getConnectedDevices();
+		modified |= selectDevice(probeSettings.serialNumber, SNptr, shouldListDevices || !hadDevices);
 		shouldListDevices = false;
+		devicesChanged = false;
+	}
+
+	if (probeSettings.debugProbe == 3)
+	{
+		GuiHelper::drawTextAlignedToSize("GDB server:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputText("##gdbServer", &probeSettings.serialNumber, 0, NULL, NULL))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("host:port of a running gdbserver (OpenOCD, pyOCD, J-Link GDB server, QEMU). The list above holds their default ports. NORMAL mode only.");
 	}
 
 	GuiHelper::drawTextAlignedToSize("SWD speed [kHz]:", alignment);
@@ -133,24 +233,43 @@ void Gui::drawDebugProbes()
 			probeSettings.device = debugProbeDevice->getTargetName();
 			modified = true;
 		}
+	}
+
+	if (probeSettings.debugProbe == 2)
+	{
+		auto simulatedSettings = simulatedProbe->getSettings();
+		bool simulatedModified = false;
 
-		GuiHelper::drawTextAlignedToSize("Mode:", alignment);
+		GuiHelper::drawTextAlignedToSize("Latency [us]:", alignment);
+		ImGui::SameLine();
+		simulatedModified |= ImGui::InputScalar("##latency", ImGuiDataType_U32, &simulatedSettings.latencyUs, NULL, NULL, "%u");
 		ImGui::SameLine();
+		ImGui::HelpMarker("Busy waited on every transaction of the simulated probe. A bulk HSS read is a single transaction.");
 
-		const char* probeModes[] = {"NORMAL", "HSS"};
-		int32_t probeMode = probeSettings.mode;
+		GuiHelper::drawTextAlignedToSize("Error rate:", alignment);
+		ImGui::SameLine();
+		simulatedModified |= ImGui::InputDouble("##errorRate", &simulatedSettings.errorRate, 0.0, 0.0, "%.6f");
+		ImGui::SameLine();
+		ImGui::HelpMarker("Probability of a failed transaction. Sampled variables are driven by sine, noise, counter and step generators chosen by their address.");
 
-		if (ImGui::Combo("##mode", &probeMode, probeModes, IM_ARRAYSIZE(probeModes)))
-		{
-			probeSettings.mode = static_cast<IDebugProbe::Mode>(probeMode);
-			modified = true;
-		}
+		if (simulatedModified)
+			simulatedProbe->setSettings(simulatedSettings);
+	}
 
-		ImGui::SameLine();
-		ImGui::HelpMarker("Select normal or high speed sampling (HSS) mode");
+	GuiHelper::drawTextAlignedToSize("Mode:", alignment);
+	ImGui::SameLine();
+
+	const char* probeModes[] = {"NORMAL", "HSS"};
+	int32_t probeMode = probeSettings.mode;
+
+	if (ImGui::Combo("##mode", &probeMode, probeModes, IM_ARRAYSIZE(probeModes)))
+	{
+		probeSettings.mode = static_cast<IDebugProbe::Mode>(probeMode);
+		modified = true;
 	}
-	else
-		probeSettings.mode = IDebugProbe::Mode::NORMAL;
+
+	ImGui::SameLine();
+	ImGui::HelpMarker("Select normal or high speed sampling (HSS) mode. J-Link samples in the probe firmware, STLink samples in a dedicated thread of the application. When the variables do not fit into the J-Link HSS set, the first ones are sampled by HSS and the rest is polled at a lower rate.");
 
 	if (devicesList.empty())
 		devicesList.push_back(noDevices);
@@ -191,6 +310,252 @@ void Gui::drawLoggingSettings(PlotHandler* handler, Settings& settings)
 	ImGui::PopID();
 }
 
+void Gui::drawTriggerSettings(ViewerDataHandler::Settings& settings)
+{
+	ImGui::PushID("trigger");
+	ImGui::Dummy(ImVec2(-1, 5));
+	GuiHelper::drawCenteredText("Trigger");
+	ImGui::SameLine();
+	ImGui::HelpMarker("When enabled, plots are updated only after the trigger condition is met. The pre-trigger samples are kept and shown together with the post-trigger samples.");
+	ImGui::Separator();
+
+	auto& trigger = settings.trigger;
+
+	GuiHelper::drawTextAlignedToSize("Type:", alignment);
+	ImGui::SameLine();
+	const char* triggerTypes[] = {"DISABLED", "LEVEL", "RISING EDGE", "FALLING EDGE", "BITMASK", "CHANGE"};
+	int32_t triggerType = static_cast<int32_t>(trigger.type);
+	if (ImGui::Combo("##type", &triggerType, triggerTypes, IM_ARRAYSIZE(triggerTypes)))
+		trigger.type = static_cast<VariableTrigger::Type>(triggerType);
+
+	ImGui::BeginDisabled(trigger.type == VariableTrigger::Type::DISABLED);
+
+	GuiHelper::drawTextAlignedToSize("Variable:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##variable", &trigger.variableName, 0, NULL, NULL);
+
+	bool isLevelTrigger = trigger.type == VariableTrigger::Type::LEVEL || trigger.type == VariableTrigger::Type::RISING_EDGE || trigger.type == VariableTrigger::Type::FALLING_EDGE;
+
+	if (isLevelTrigger)
+	{
+		GuiHelper::drawTextAlignedToSize("Level:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##level", &trigger.level);
+	}
+	else if (trigger.type == VariableTrigger::Type::BITMASK)
+	{
+		GuiHelper::drawTextAlignedToSize("Mask:", alignment);
+		ImGui::SameLine();
+		ImGui::InputScalar("##mask", ImGuiDataType_U32, &trigger.mask, NULL, NULL, "0x%08X", ImGuiInputTextFlags_CharsHexadecimal);
+
+		GuiHelper::drawTextAlignedToSize("Value:", alignment);
+		ImGui::SameLine();
+		ImGui::InputScalar("##value", ImGuiDataType_U32, &trigger.value, NULL, NULL, "0x%08X", ImGuiInputTextFlags_CharsHexadecimal);
+		ImGui::SameLine();
+		ImGui::HelpMarker("Triggers when the masked raw memory word equals the masked value.");
+	}
+
+	GuiHelper::drawTextAlignedToSize("Pre-trigger points:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##pre", ImGuiDataType_U32, &trigger.preTriggerPoints, NULL, NULL, "%u");
+	trigger.preTriggerPoints = std::min(trigger.preTriggerPoints, settings.maxPoints);
+
+	GuiHelper::drawTextAlignedToSize("Post-trigger points:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##post", ImGuiDataType_U32, &trigger.postTriggerPoints, NULL, NULL, "%u");
+	trigger.postTriggerPoints = std::clamp(trigger.postTriggerPoints, static_cast<uint32_t>(1), std::max(static_cast<uint32_t>(1), settings.maxPoints - trigger.preTriggerPoints));
+
+	GuiHelper::drawTextAlignedToSize("Rearm:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##rearm", &trigger.rearm);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Wait for the next trigger after the post-trigger points are collected instead of stopping the acquisition.");
+
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
+void Gui::drawStimulusSettings(ViewerDataHandler::Settings& settings)
+{
+	ImGui::PushID("stimulus");
+	ImGui::Dummy(ImVec2(-1, 5));
+	GuiHelper::drawCenteredText("Stimulus");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Writes a generated waveform to the selected variable during the acquisition. Writes are interleaved with the reads, so the achievable rate depends on the debug probe.");
+	ImGui::Separator();
+
+	auto& stimulus = settings.stimulus;
+
+	GuiHelper::drawTextAlignedToSize("Type:", alignment);
+	ImGui::SameLine();
+	const char* stimulusTypes[] = {"DISABLED", "STEP", "RAMP", "SINE", "CHIRP", "PROFILE"};
+	int32_t stimulusType = static_cast<int32_t>(stimulus.type);
+	if (ImGui::Combo("##type", &stimulusType, stimulusTypes, IM_ARRAYSIZE(stimulusTypes)))
+		stimulus.type = static_cast<StimulusGenerator::Type>(stimulusType);
+
+	ImGui::BeginDisabled(stimulus.type == StimulusGenerator::Type::DISABLED);
+
+	GuiHelper::drawTextAlignedToSize("Variable:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##variable", &stimulus.variableName, 0, NULL, NULL);
+
+	GuiHelper::drawTextAlignedToSize("Write rate [Hz]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##writeFrequency", ImGuiDataType_U32, &stimulus.writeFrequencyHz, NULL, NULL, "%u");
+	stimulus.writeFrequencyHz = std::clamp(stimulus.writeFrequencyHz, ViewerDataHandler::minSamplinFrequencyHz, ViewerDataHandler::maxSamplinFrequencyHz);
+
+	if (stimulus.type == StimulusGenerator::Type::PROFILE)
+	{
+		GuiHelper::drawTextAlignedToSize("Profile:", alignment);
+		ImGui::SameLine();
+		ImGui::InputText("##profile", &stimulus.profilePath, 0, NULL, NULL);
+		ImGui::SameLine();
+		if (ImGui::Button("...", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)))
+		{
+			std::string path = fileHandler->openFile({"CSV files", "csv"});
+			if (path != "")
+				stimulus.profilePath = path;
+		}
+		ImGui::SameLine();
+		ImGui::HelpMarker("CSV file with \"time,value\" lines. Time in seconds, values are linearly interpolated.");
+	}
+	else
+	{
+		GuiHelper::drawTextAlignedToSize("Offset:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##offset", &stimulus.offset);
+
+		GuiHelper::drawTextAlignedToSize("Amplitude:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##amplitude", &stimulus.amplitude);
+	}
+
+	if (stimulus.type == StimulusGenerator::Type::STEP || stimulus.type == StimulusGenerator::Type::RAMP || stimulus.type == StimulusGenerator::Type::CHIRP)
+	{
+		GuiHelper::drawTextAlignedToSize(stimulus.type == StimulusGenerator::Type::STEP ? "Step time [s]:" : "Period [s]:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##time", &stimulus.time);
+	}
+
+	if (stimulus.type == StimulusGenerator::Type::SINE || stimulus.type == StimulusGenerator::Type::CHIRP)
+	{
+		GuiHelper::drawTextAlignedToSize(stimulus.type == StimulusGenerator::Type::SINE ? "Frequency [Hz]:" : "Start frequency [Hz]:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##frequency", &stimulus.frequencyHz);
+	}
+
+	if (stimulus.type == StimulusGenerator::Type::CHIRP)
+	{
+		GuiHelper::drawTextAlignedToSize("End frequency [Hz]:", alignment);
+		ImGui::SameLine();
+		ImGui::InputDouble("##endFrequency", &stimulus.endFrequencyHz);
+	}
+
+	auto statistics = viewerDataHandler->getStimulusStatistics();
+	GuiHelper::drawTextAlignedToSize("Writes:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("%llu (missed: %llu, failed: %llu)", static_cast<unsigned long long>(statistics.writes), static_cast<unsigned long long>(statistics.missedWrites), static_cast<unsigned long long>(statistics.failedWrites));
+	GuiHelper::drawTextAlignedToSize("Lateness [us]:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("mean: %.1f, max: %.1f", statistics.meanLatenessUs, statistics.maxLatenessUs);
+
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
+void Gui::drawRttSettings(ViewerDataHandler::Settings& settings)
+{
+	ImGui::PushID("rtt");
+	ImGui::Dummy(ImVec2(-1, 5));
+	GuiHelper::drawCenteredText("RTT");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Drains a SEGGER RTT up-buffer through the debug probe memory access in the normal mode. The target writes {uint8_t channel, uint32_t timestamp, uint32_t value} records, each channel updates the variable bound to it.");
+	ImGui::Separator();
+
+	auto& rtt = settings.rtt;
+
+	GuiHelper::drawTextAlignedToSize("Enabled:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##enabled", &rtt.enabled);
+
+	ImGui::BeginDisabled(!rtt.enabled);
+
+	GuiHelper::drawTextAlignedToSize("Up-buffer:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##upBuffer", ImGuiDataType_U32, &rtt.upBuffer, NULL, NULL, "%u");
+
+	GuiHelper::drawTextAlignedToSize("Read rate [Hz]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##readFrequency", ImGuiDataType_U32, &rtt.readFrequencyHz, NULL, NULL, "%u");
+	rtt.readFrequencyHz = std::clamp(rtt.readFrequencyHz, ViewerDataHandler::minSamplinFrequencyHz, ViewerDataHandler::maxSamplinFrequencyHz);
+
+	GuiHelper::drawTextAlignedToSize("Channel variables:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##channelVariables", &rtt.channelVariables, 0, NULL, NULL);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Comma separated variable names, the first one is bound to channel 0. Bound variables are not read from the memory.");
+
+	GuiHelper::drawTextAlignedToSize("RAM start:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##ramStart", ImGuiDataType_U32, &rtt.ramStart, NULL, NULL, "0x%08X", ImGuiInputTextFlags_CharsHexadecimal);
+
+	GuiHelper::drawTextAlignedToSize("RAM size:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##ramSize", ImGuiDataType_U32, &rtt.ramSize, NULL, NULL, "0x%08X", ImGuiInputTextFlags_CharsHexadecimal);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Searched for the control block when the *.elf file has no _SEGGER_RTT symbol.");
+
+	auto statistics = viewerDataHandler->getRttStatistics();
+	GuiHelper::drawTextAlignedToSize("Control block:", alignment);
+	ImGui::SameLine();
+	if (statistics.isAttached)
+		ImGui::Text("0x%08X", statistics.controlBlockAddress);
+	else
+		ImGui::Text("%s", statistics.lastErrorMsg.empty() ? "-" : statistics.lastErrorMsg.c_str());
+	GuiHelper::drawTextAlignedToSize("Received:", alignment);
+	ImGui::SameLine();
+	ImGui::Text("%llu records (%llu bytes)", static_cast<unsigned long long>(statistics.records), static_cast<unsigned long long>(statistics.bytesRead));
+
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
+void Gui::drawThreadPrioritySettings(ThreadPriority::Settings& settings)
+{
+	ImGui::PushID("threadPriority");
+	ImGui::Dummy(ImVec2(-1, 5));
+	GuiHelper::drawCenteredText("Acquisition thread");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Scheduling of the acquisition threads, applied on each start. Real-time policies require root privileges or CAP_SYS_NICE, otherwise the default scheduling is used and a warning is logged. Linux only.");
+	ImGui::Separator();
+
+	ImGui::BeginDisabled(!ThreadPriority::isSupported());
+
+	const char* policies[] = {"default", "FIFO", "round robin"};
+	int32_t policyCombo = static_cast<int32_t>(settings.policy);
+	GuiHelper::drawTextAlignedToSize("Policy:", alignment);
+	ImGui::SameLine();
+	if (ImGui::Combo("##policy", &policyCombo, policies, IM_ARRAYSIZE(policies)))
+		settings.policy = static_cast<ThreadPriority::Policy>(policyCombo);
+
+	ImGui::BeginDisabled(settings.policy == ThreadPriority::Policy::DEFAULT);
+	GuiHelper::drawTextAlignedToSize("Priority:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##priority", ImGuiDataType_S32, &settings.priority, NULL, NULL, "%d");
+	settings.priority = std::clamp(settings.priority, 1, 99);
+	ImGui::EndDisabled();
+
+	GuiHelper::drawTextAlignedToSize("CPU core:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##cpuCore", ImGuiDataType_S32, &settings.cpuCore, NULL, NULL, "%d");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Core the thread is pinned to. Use -1 to let the scheduler choose any core.");
+	settings.cpuCore = std::clamp(settings.cpuCore, -1, ThreadPriority::getCoreCount() - 1);
+
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
 void Gui::drawGdbSettings(ViewerDataHandler::Settings& settings)
 {
 	ImGui::PushID("advanced");
@@ -235,6 +600,7 @@ void Gui::acqusitionSettingsTrace()
 
 	drawTraceProbes();
 	drawLoggingSettings(tracePlotHandler, settings);
+	drawThreadPrioritySettings(settings.threadPriority);
 	traceDataHandler->setSettings(settings);
 }
 
@@ -286,15 +652,17 @@ void Gui::drawTraceProbes()
 
 	ImGui::SameLine();
 
-	if (ImGui::Button("@", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)) || shouldListDevices || devicesList.empty())
+	if (ImGui::Button("@", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)))
+		probeDiscovery->requestRescan();
+
+	if (shouldListDevices || devicesChanged || devicesList.empty())
 	{
-		devicesList = traceProbeDevice->getConnectedDevices();
-		if (!devicesList.empty())
-		{
-			probeSettings.serialNumber = devicesList[0];
-			modified = true;
-		}
+		const bool hadDevices = !devicesList.empty() && devicesList.front() != noDevices;
+		const char* source = getDiscoverySource(probeSettings.debugProbe);
+		devicesList = source != nullptr ? probeDiscovery->getDevices(source) : traceProbeDevice->getConnectedDevices();
+		modified |= selectDevice(probeSettings.serialNumber, SNptr, shouldListDevices || !hadDevices);
 		shouldListDevices = false;
+		devicesChanged = false;
 	}
 
 	GuiHelper::drawTextAlignedToSize("SWD speed [kHz]:", alignment);
@@ -1,6 +1,8 @@
 #ifndef _GUI_PLOTEDIT_HPP
 #define _GUI_PLOTEDIT_HPP
 
+#include <mutex>
+
 #include "GuiHelper.hpp"
 #include "GuiSelectVariable.hpp"
 #include "Plot.hpp"
@@ -11,7 +13,7 @@
 class PlotEditWindow
 {
    public:
-	PlotEditWindow(PlotHandler* plotHandler, PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler) : plotHandler(plotHandler), plotGroupHandler(plotGroupHandler), variableHandler(variableHandler)
+	PlotEditWindow(PlotHandler* plotHandler, PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, std::mutex* mtx) : plotHandler(plotHandler), plotGroupHandler(plotGroupHandler), variableHandler(variableHandler), mtx(mtx)
 	{
 		selectVariableWindow = std::make_unique<SelectVariableWindow>(variableHandler, &selection, 1);
 	}
@@ -88,14 +90,47 @@ class PlotEditWindow
 				popup.show("Error!", "Plot already exists!", 1.5f);
 		}
 
-		const char* plotTypes[] = {"curve", "bar", "table", "XY"};
+		const char* plotTypes[] = {"curve", "bar", "table", "XY", "array"};
 		int32_t typeCombo = (int32_t)editedPlot->getType();
 		GuiHelper::drawTextAlignedToSize("type:", alignment);
 		ImGui::SameLine();
 		if (ImGui::Combo("##combo", &typeCombo, plotTypes, IM_ARRAYSIZE(plotTypes)))
 			editedPlot->setType((Plot::Type)typeCombo);
 
-		if (editedPlot->getType() == Plot::Type::XY)
+		uint32_t sampleFrequency = editedPlot->getSampleFrequency();
+		GuiHelper::drawTextAlignedToSize("sampling [Hz]:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputScalar("##sampleFrequency", ImGuiDataType_U32, &sampleFrequency, NULL, NULL, "%u"))
+			editedPlot->setSampleFrequency(sampleFrequency);
+		ImGui::SameLine();
+		ImGui::HelpMarker("Sampling frequency of this plot's series. Use 0 to sample with the acquisition sampling frequency. Lower rates leave more probe bandwidth for the fast plots.");
+
+		if (editedPlot->getType() == Plot::Type::CURVE)
+		{
+			uint32_t decimationFactor = editedPlot->getDecimationFactor();
+			GuiHelper::drawTextAlignedToSize("decimation:", alignment);
+			ImGui::SameLine();
+			if (ImGui::InputScalar("##decimationFactor", ImGuiDataType_U32, &decimationFactor, NULL, NULL, "%u"))
+				editedPlot->setDecimationFactor(std::min(decimationFactor, maxDecimationFactor));
+			ImGui::SameLine();
+			ImGui::HelpMarker("Number of samples reduced to a single min/max/mean point of the long history kept next to the full rate buffer. Short spikes stay visible in the long history. Use 0 to disable.");
+
+			ImGui::BeginDisabled(decimationFactor == 0);
+			uint32_t decimatedMaxPoints = editedPlot->getDecimatedMaxPoints();
+			GuiHelper::drawTextAlignedToSize("history points:", alignment);
+			ImGui::SameLine();
+			if (ImGui::InputScalar("##decimatedMaxPoints", ImGuiDataType_U32, &decimatedMaxPoints, NULL, NULL, "%u"))
+				editedPlot->setDecimatedMaxPoints(std::clamp(decimatedMaxPoints, minDecimatedPoints, maxDecimatedPoints));
+
+			const char* decimationModes[] = {"min/max envelope", "average", "peak hold"};
+			int32_t decimationModeCombo = static_cast<int32_t>(editedPlot->getDecimationMode());
+			GuiHelper::drawTextAlignedToSize("history view:", alignment);
+			ImGui::SameLine();
+			if (ImGui::Combo("##decimationMode", &decimationModeCombo, decimationModes, IM_ARRAYSIZE(decimationModes)))
+				editedPlot->setDecimationMode(static_cast<Plot::DecimationMode>(decimationModeCombo));
+			ImGui::EndDisabled();
+		}
+		else if (editedPlot->getType() == Plot::Type::XY)
 		{
 			GuiHelper::drawTextAlignedToSize("X-axis variable:", alignment);
 			ImGui::SameLine();
@@ -114,6 +149,42 @@ class PlotEditWindow
 			if (ImGui::Button("select...", ImVec2(65 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)))
 				selectVariableWindow->setShowState(true);
 		}
+		else if (editedPlot->getType() == Plot::Type::ARRAY)
+		{
+			uint32_t arrayLength = editedPlot->getArrayLength();
+			GuiHelper::drawTextAlignedToSize("length:", alignment);
+			ImGui::SameLine();
+			if (ImGui::InputScalar("##arrayLength", ImGuiDataType_U32, &arrayLength, NULL, NULL, "%u"))
+			{
+				/* the frame buffers are filled by the processing stage */
+				std::lock_guard<std::mutex> lock(*mtx);
+				editedPlot->setArrayLength(arrayLength);
+			}
+			ImGui::SameLine();
+			ImGui::HelpMarker("Number of elements read starting at the series address. The element type is the type of the series variable.");
+
+			uint32_t arrayPersistence = editedPlot->getArrayPersistence();
+			GuiHelper::drawTextAlignedToSize("persistence:", alignment);
+			ImGui::SameLine();
+			if (ImGui::InputScalar("##arrayPersistence", ImGuiDataType_U32, &arrayPersistence, NULL, NULL, "%u"))
+			{
+				std::lock_guard<std::mutex> lock(*mtx);
+				editedPlot->setArrayPersistence(arrayPersistence);
+			}
+			ImGui::SameLine();
+			ImGui::HelpMarker("Number of snapshots drawn at once, older snapshots fade out.");
+
+			uint32_t arrayAveraging = editedPlot->getArrayAveraging();
+			GuiHelper::drawTextAlignedToSize("averaging:", alignment);
+			ImGui::SameLine();
+			if (ImGui::InputScalar("##arrayAveraging", ImGuiDataType_U32, &arrayAveraging, NULL, NULL, "%u"))
+			{
+				std::lock_guard<std::mutex> lock(*mtx);
+				editedPlot->setArrayAveraging(arrayAveraging);
+			}
+			ImGui::SameLine();
+			ImGui::HelpMarker("Number of snapshots in the running average drawn on top of the latest snapshot. Use 1 to disable averaging.");
+		}
 	}
 
    private:
@@ -122,6 +193,9 @@ class PlotEditWindow
 	 *
 	 */
 	static constexpr size_t alignment = 18;
+	static constexpr uint32_t maxDecimationFactor = 100000;
+	static constexpr uint32_t minDecimatedPoints = 100;
+	static constexpr uint32_t maxDecimatedPoints = 200000;
 
 	bool showPlotEditWindow = false;
 	bool stateChanged = false;
@@ -131,6 +205,7 @@ class PlotEditWindow
 	PlotHandler* plotHandler;
 	PlotGroupHandler* plotGroupHandler;
 	VariableHandler* variableHandler;
+	std::mutex* mtx;
 
 	Popup popup;
 
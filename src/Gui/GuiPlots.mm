@@ -61,6 +61,8 @@ void Gui::drawPlots()
 				drawPlotBar(plot);
 			else if (plot->getType() == Plot::Type::XY)
 				drawPlotXY(plot);
+			else if (plot->getType() == Plot::Type::ARRAY)
+				drawPlotArray(plot);
 		}
 
 		ImPlot::EndSubplots();
@@ -131,7 +133,8 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 			ViewerDataHandler::Settings settings = viewerDataHandler->getSettings();
 			ImPlot::SetupAxis(ImAxis_Y1, NULL, ImPlotAxisFlags_AutoFit);
 			ImPlot::SetupAxis(ImAxis_X1, "time[s]", 0);
-			const double viewportWidth = (1.0 / viewerDataHandler->getAverageSamplingFrequency()) * settings.maxViewportPoints;
+			const uint32_t sampleDivider = ViewerDataHandler::calculateSampleDivider(settings.sampleFrequencyHz, plot->getSampleFrequency());
+			const double viewportWidth = (sampleDivider / viewerDataHandler->getAverageSamplingFrequency()) * settings.maxViewportPoints;
 			const double min = *time.getLastElement() < viewportWidth ? 0.0f : *time.getLastElement() - viewportWidth;
 			const double max = min == 0.0f ? *time.getLastElement() : min + viewportWidth;
 			ImPlot::SetupAxisLimits(ImAxis_X1, min, max, ImPlotCond_Always);
@@ -169,11 +172,16 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 			if (!serPtr->visible)
 				continue;
 			serPtr->buffer->copyData();
+			if (plot->getDecimationFactor() > 0)
+				serPtr->decimatedBuffer->copyData();
 		}
 		uint32_t offset = time.getOffset();
 		uint32_t size = time.getSize();
 		mtx->unlock();
 
+		if (plot->getDecimationFactor() > 0)
+			drawDecimatedHistory(plot);
+
 		for (auto& [key, serPtr] : seriesMap)
 		{
 			if (!serPtr->visible)
@@ -197,6 +205,99 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 		ImPlot::EndPlot();
 	}
 }
+void Gui::drawPlotArray(std::shared_ptr<Plot> plot)
+{
+	auto& seriesMap = plot->getSeriesMap();
+
+	if (ImPlot::BeginPlot(plot->getName().c_str(), ImVec2(-1, -1), ImPlotFlags_NoChild))
+	{
+		if (viewerDataHandler->getState() == DataHandlerBase::State::RUN)
+		{
+			ImPlot::SetupAxis(ImAxis_Y1, NULL, ImPlotAxisFlags_AutoFit);
+			ImPlot::SetupAxis(ImAxis_X1, "index", ImPlotAxisFlags_AutoFit);
+		}
+		else
+		{
+			ImPlot::SetupAxes("index", NULL, 0, 0);
+			ImPlot::SetupAxisLimits(ImAxis_X1, 0, plot->getArrayLength(), ImPlotCond_Once);
+			ImPlot::SetupAxisLimits(ImAxis_Y1, -0.1, 0.1, ImPlotCond_Once);
+		}
+
+		plot->setIsHovered(ImPlot::IsPlotHovered());
+		dragAndDropPlot(plot);
+
+		for (auto& [key, serPtr] : seriesMap)
+		{
+			if (!serPtr->visible)
+				continue;
+
+			/* thread safe copies of the snapshots, the newest frame goes first */
+			std::vector<std::vector<double>> frames;
+			std::vector<double> average;
+			mtx->lock();
+			for (size_t i = 0; i < serPtr->frames.getFrameCount(); i++)
+				frames.push_back(serPtr->frames.getFrame(i));
+			if (plot->getArrayAveraging() > 1)
+				average = serPtr->frames.getAverage();
+			mtx->unlock();
+
+			Variable::Color color = serPtr->var->getColor();
+
+			/* oldest snapshots are drawn first so that the newest one stays on top */
+			for (size_t i = frames.size(); i-- > 0;)
+			{
+				const float alpha = 1.0f - static_cast<float>(i) / frames.size();
+				ImPlot::SetNextLineStyle(ImVec4(color.r, color.g, color.b, alpha));
+				ImPlot::PlotLine(i == 0 ? key.c_str() : ("##" + key + std::to_string(i)).c_str(), frames[i].data(), frames[i].size());
+			}
+
+			if (!average.empty())
+			{
+				ImPlot::SetNextLineStyle(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), 2.0f);
+				ImPlot::PlotLine((key + " avg").c_str(), average.data(), average.size());
+			}
+		}
+
+		ImPlot::EndPlot();
+	}
+}
+
+void Gui::drawDecimatedHistory(std::shared_ptr<Plot> plot)
+{
+	using Bucket = DecimatingBuffer<double>::Bucket;
+
+	for (auto& [key, serPtr] : plot->getSeriesMap())
+	{
+		if (!serPtr->visible)
+			continue;
+
+		auto& buffer = *serPtr->decimatedBuffer;
+		const Bucket* buckets = buffer.getFirstElementCopy();
+		const int32_t size = buffer.getSizeCopy();
+		const int32_t offset = buffer.getOffsetCopy();
+		const std::string label = "##history" + key;
+		Variable::Color color = serPtr->var->getColor();
+
+		switch (plot->getDecimationMode())
+		{
+			case Plot::DecimationMode::ENVELOPE:
+				ImPlot::SetNextFillStyle(ImVec4(color.r, color.g, color.b, 1.0f), 0.3f);
+				ImPlot::PlotShaded(label.c_str(), &buckets->time, &buckets->min, &buckets->max, size, ImPlotShadedFlags_None, offset, sizeof(Bucket));
+				ImPlot::SetNextLineStyle(ImVec4(color.r, color.g, color.b, 0.5f));
+				ImPlot::PlotLine(label.c_str(), &buckets->time, &buckets->mean, size, ImPlotLineFlags_None, offset, sizeof(Bucket));
+				break;
+			case Plot::DecimationMode::AVERAGE:
+				ImPlot::SetNextLineStyle(ImVec4(color.r, color.g, color.b, 0.5f));
+				ImPlot::PlotLine(label.c_str(), &buckets->time, &buckets->mean, size, ImPlotLineFlags_None, offset, sizeof(Bucket));
+				break;
+			case Plot::DecimationMode::PEAK_HOLD:
+				ImPlot::SetNextLineStyle(ImVec4(color.r, color.g, color.b, 0.5f));
+				ImPlot::PlotStairs(label.c_str(), &buckets->time, &buckets->max, size, ImPlotStairsFlags_None, offset, sizeof(Bucket));
+				break;
+		}
+	}
+}
+
 void Gui::drawPlotBar(std::shared_ptr<Plot> plot)
 {
 	auto& seriesMap = plot->getSeriesMap();
@@ -305,8 +406,13 @@ void Gui::drawPlotTable(std::shared_ptr<Plot> plot)
 				if (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter))
 				{
 					logger->info("New value to be written: {}", valueToWrite);
-					if (!viewerDataHandler->writeSeriesValue(*serPtr->var, std::stod(valueToWrite)))
-						logger->error("Error while writing new value!");
+					auto onComplete = [this](bool result)
+					{
+						if (!result)
+							logger->error("Error while writing new value!");
+					};
+					if (!viewerDataHandler->writeSeriesValue(*serPtr->var, std::stod(valueToWrite), onComplete))
+						logger->error("Too many pending writes, value dropped!");
 				}
 			}
 			ImGui::PopStyleColor(3);
@@ -178,7 +178,6 @@ class PlotsTree
 			std::optional<std::string> seriesNameToDelete = {};
 			for (auto& [name, ser] : plt->getSeriesMap())
 			{
-				ImGui::BeginDisabled(!ser->var->getIsCurrentlySampled() && viewerDataHandler->getState() == DataHandlerBase::State::RUN);
 				ImGui::PushID(name.c_str());
 				ImGui::Checkbox("", &ser->visible);
 				ImGui::PopID();
@@ -190,7 +189,6 @@ class PlotsTree
 				if (!seriesNameToDelete.has_value())
 					seriesNameToDelete = GuiHelper::showDeletePopup("Delete var", name);
 				ImGui::PopID();
-				ImGui::EndDisabled();
 			}
 			plt->removeSeries(seriesNameToDelete.value_or(""));
 
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include "GuiHelper.hpp"
+#include "IFileHandler.hpp"
+#include "ProbeStatistics.hpp"
+#include "TraceDataHandler.hpp"
+#include "ViewerDataHandler.hpp"
+#include "imgui.h"
+#include "spdlog/spdlog.h"
+
+class ProbeDiagnosticsWindow
+{
+   public:
+	ProbeDiagnosticsWindow(ViewerDataHandler* viewerDataHandler, TraceDataHandler* traceDataHandler, IFileHandler* fileHandler, spdlog::logger* logger) : viewerDataHandler(viewerDataHandler), traceDataHandler(traceDataHandler), fileHandler(fileHandler), logger(logger)
+	{
+	}
+
+	void draw(bool& show)
+	{
+		if (!show)
+			return;
+
+		if (ImGui::Begin("Probe diagnostics", &show))
+		{
+			if (ImGui::BeginTabBar("##probeDiagnosticsTabs"))
+			{
+				if (ImGui::BeginTabItem("Var Viewer"))
+				{
+					drawStatistics(viewerDataHandler->getProbeStatistics());
+					ImGui::EndTabItem();
+				}
+				if (ImGui::BeginTabItem("Trace Viewer"))
+				{
+					drawStatistics(traceDataHandler->getProbeStatistics());
+					ImGui::EndTabItem();
+				}
+				ImGui::EndTabBar();
+			}
+		}
+		ImGui::End();
+	}
+
+   private:
+	void drawStatistics(ProbeStatistics* statistics)
+	{
+		if (statistics == nullptr)
+		{
+			ImGui::Text("No probe selected");
+			return;
+		}
+
+		static ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable;
+		if (ImGui::BeginTable("##probeStatistics", 9, flags))
+		{
+			ImGui::TableSetupColumn("operation");
+			ImGui::TableSetupColumn("calls");
+			ImGui::TableSetupColumn("failures");
+			ImGui::TableSetupColumn("retries");
+			ImGui::TableSetupColumn("mean [us]");
+			ImGui::TableSetupColumn("p50 [us]");
+			ImGui::TableSetupColumn("p90 [us]");
+			ImGui::TableSetupColumn("p99 [us]");
+			ImGui::TableSetupColumn("max [us]");
+			ImGui::TableHeadersRow();
+
+			for (size_t i = 0; i < ProbeStatistics::operationCount; i++)
+			{
+				auto summary = statistics->getSummary(static_cast<ProbeStatistics::Operation>(i));
+				auto& latency = summary.latency;
+
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%s", ProbeStatistics::operationNames[i]);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%llu", static_cast<unsigned long long>(latency.count));
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%llu", static_cast<unsigned long long>(summary.failures));
+				ImGui::TableSetColumnIndex(3);
+				ImGui::Text("%llu", static_cast<unsigned long long>(summary.retries));
+				ImGui::TableSetColumnIndex(4);
+				ImGui::Text("%.1f", latency.getMean() / 1000.0);
+				ImGui::TableSetColumnIndex(5);
+				ImGui::Text("%.1f", latency.getPercentile(50.0) / 1000.0);
+				ImGui::TableSetColumnIndex(6);
+				ImGui::Text("%.1f", latency.getPercentile(90.0) / 1000.0);
+				ImGui::TableSetColumnIndex(7);
+				ImGui::Text("%.1f", latency.getPercentile(99.0) / 1000.0);
+				ImGui::TableSetColumnIndex(8);
+				ImGui::Text("%.1f", latency.max / 1000.0);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::Button("Reset"))
+			statistics->reset();
+		ImGui::SameLine();
+		if (ImGui::Button("Dump to file"))
+			dump(*statistics);
+		ImGui::SameLine();
+		ImGui::HelpMarker("Latency of every probe call, measured around the probe library call only - time spent waiting for the probe lock or in MCUViewer is not included. readMemoryBatch is a whole sampling tick, readEntries is a single HSS buffer read. Retries are packet retransmissions of the GDB server probe.");
+	}
+
+	void dump(const ProbeStatistics& statistics)
+	{
+		std::string path = fileHandler->saveFile(std::pair<std::string, std::string>("CSV", "csv"));
+		if (path.empty())
+			return;
+
+		std::ofstream file(path);
+		if (!file)
+		{
+			logger->info("Error opening the file: {}", path);
+			return;
+		}
+
+		file << statistics.dump();
+		logger->info("Probe diagnostics saved to {}", path);
+	}
+
+	ViewerDataHandler* viewerDataHandler;
+	TraceDataHandler* traceDataHandler;
+	IFileHandler* fileHandler;
+	spdlog::logger* logger;
+};
@@ -139,7 +139,7 @@ class VariableTableWindow
 
 		ImGui::EndDisabled();
 
-		variableEditWindow->draw();
+		variableEditWindow->draw(viewerDataHandler->getState() == DataHandlerBase::State::RUN);
 		importVariablesWindow->draw();
 	}
 
@@ -162,25 +162,38 @@ class VariableTableWindow
 	void drawUpdateAddressesFromElf()
 	{
 		static std::future<bool> refreshThread{};
+		static bool isRttLookup = false;
 		static bool shouldPopStyle = false;
 
 		static constexpr size_t textSize = 40;
 		char buttonText[textSize]{};
 
-		if (refreshThread.valid() && refreshThread.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		const bool isRefreshing = refreshThread.valid() && refreshThread.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+
+		if (isRefreshing)
 			snprintf(buttonText, textSize, "Update variable addresses %c", "|/-\\"[(int)(ImGui::GetTime() / 0.05f) & 3]);
 		else
 		{
 			snprintf(buttonText, textSize, "Update variable addresses");
-			if (refreshThread.valid() && !refreshThread.get())
-				popup.show("Error!", "Update error. Please check the *.elf file path!", 2.0f);
+			if (refreshThread.valid())
+			{
+				const bool result = refreshThread.get();
+				if (result || isRttLookup)
+					viewerDataHandler->setRttControlBlockAddress(parser->getRttControlBlockAddress().value_or(0));
+				if (!result && !isRttLookup)
+					popup.show("Error!", "Update error. Please check the *.elf file path!", 2.0f);
+			}
 		}
 
 		ImGui::BeginDisabled(projectElfPath->empty());
 
 		bool elfChanged = checkElfFileChanged();
 
-		performVariablesUpdate = importVariablesWindow->shouldPerformVariableUpdate();
+		if (checkRttControlBlockOutdated())
+			performRttUpdate = true;
+
+		if (importVariablesWindow->shouldPerformVariableUpdate())
+			performVariablesUpdate = true;
 
 		if (elfChanged)
 		{
@@ -203,12 +216,25 @@ class VariableTableWindow
 			shouldPopStyle = true;
 		}
 
-		if (ImGui::Button(buttonText, ImVec2(-1, 25 * GuiHelper::contentScale)) || performVariablesUpdate)
+		if (ImGui::Button(buttonText, ImVec2(-1, 25 * GuiHelper::contentScale)))
+			performVariablesUpdate = true;
+
+		/* the parser runs one gdb process at a time, requests wait until the running one is done */
+		if (performVariablesUpdate && !isRefreshing)
 		{
 			parser->changeCurrentGDBCommand(viewerDataHandler->getSettings().gdbCommand);
 			lastModifiedTime = std::filesystem::file_time_type::clock::now();
 			refreshThread = std::async(std::launch::async, &GdbParser::updateVariableMap, parser, GuiHelper::convertProjectPathToAbsolute(projectElfPath, projectConfigPath));
+			isRttLookup = false;
 			performVariablesUpdate = false;
+			performRttUpdate = false;
+		}
+		else if (performRttUpdate && !isRefreshing)
+		{
+			parser->changeCurrentGDBCommand(viewerDataHandler->getSettings().gdbCommand);
+			refreshThread = std::async(std::launch::async, &GdbParser::updateRttControlBlockAddress, parser, GuiHelper::convertProjectPathToAbsolute(projectElfPath, projectConfigPath));
+			isRttLookup = true;
+			performRttUpdate = false;
 		}
 
 		/* TODO fix this ugly solution */
@@ -230,6 +256,28 @@ class VariableTableWindow
 		return writeTime > lastModifiedTime;
 	}
 
+	/* the RTT control block moves with every build, it is looked up for an opened project, a newly selected *.elf file or a rebuild */
+	bool checkRttControlBlockOutdated()
+	{
+		std::string path = GuiHelper::convertProjectPathToAbsolute(projectElfPath, projectConfigPath);
+		if (path != rttElfPath)
+		{
+			rttElfPath = path;
+			rttElfWriteTime = {};
+			viewerDataHandler->setRttControlBlockAddress(0);
+		}
+
+		if (projectElfPath->empty() || !std::filesystem::exists(path))
+			return false;
+
+		auto writeTime = std::filesystem::last_write_time(path);
+		if (writeTime == rttElfWriteTime)
+			return false;
+
+		rttElfWriteTime = writeTime;
+		return true;
+	}
+
 	void drawMenuVariablePopup(const std::string& name, std::function<void()> onNew, std::function<void(const std::string&)> onCopy, std::function<void(const std::string&)> onDelete, std::function<void(const std::string&)> onProperties)
 	{
 		ImGui::PushID(name.c_str());
@@ -267,5 +315,9 @@ class VariableTableWindow
 
 	std::filesystem::file_time_type lastModifiedTime = std::filesystem::file_time_type::clock::now();
 
+	std::string rttElfPath;
+	std::filesystem::file_time_type rttElfWriteTime{};
+
 	bool performVariablesUpdate = false;
+	bool performRttUpdate = false;
 };
\ No newline at end of file
@@ -18,7 +18,7 @@ class VariableEditWindow
 		selectVariableWindowBase = std::make_unique<SelectVariableWindow>(variableHandler, &selectionBase, 2);
 	}
 
-	void draw()
+	void draw(bool isAcquisitionRunning)
 	{
 		if (showVariableEditWindow)
 			ImGui::OpenPopup("Variable Edit");
@@ -27,7 +27,7 @@ class VariableEditWindow
 		ImGui::SetNextWindowSize(ImVec2(800 * GuiHelper::contentScale, 500 * GuiHelper::contentScale));
 		if (ImGui::BeginPopupModal("Variable Edit", &showVariableEditWindow, 0))
 		{
-			drawVariableEditSettings();
+			drawVariableEditSettings(isAcquisitionRunning);
 
 			const float buttonHeight = 25.0f * GuiHelper::contentScale;
 			ImGui::SetCursorPos(ImVec2(0, ImGui::GetWindowSize().y - buttonHeight / 2.0f - ImGui::GetFrameHeightWithSpacing()));
@@ -59,7 +59,7 @@ class VariableEditWindow
 		showVariableEditWindow = state;
 	}
 
-	void drawVariableEditSettings()
+	void drawVariableEditSettings(bool isAcquisitionRunning)
 	{
 		if (editedVariable == nullptr)
 			return;
@@ -69,6 +69,7 @@ class VariableEditWindow
 		std::string size = std::to_string(editedVariable->getSize());
 		std::string shift = std::to_string(editedVariable->getShift());
 		std::string mask = std::string("0x") + std::string(GuiHelper::intToHexString(editedVariable->getMask()));
+		std::string pointerOffsets = editedVariable->getPointerOffsetsString();
 		bool shouldUpdateFromElf = editedVariable->getShouldUpdateFromElf();
 		bool selectNameManually = editedVariable->getIsTrackedNameDifferent();
 
@@ -177,6 +178,21 @@ class VariableEditWindow
 
 		ImGui::EndDisabled();
 
+		/* POINTER CHAIN */
+		/* the acquisition thread resolves the chain while running */
+		ImGui::BeginDisabled(isAcquisitionRunning);
+		GuiHelper::drawTextAlignedToSize("pointer offsets:", alignment);
+		ImGui::SameLine();
+		ImGui::InputText("##pointerOffsets", &pointerOffsets, ImGuiInputTextFlags_None, NULL, NULL);
+		if (ImGui::IsItemDeactivatedAfterEdit())
+		{
+			if (!editedVariable->setPointerOffsetsFromString(pointerOffsets))
+				popup.show("Error!", "Incorrect pointer offsets!", 1.5f);
+		}
+		ImGui::EndDisabled();
+		ImGui::SameLine();
+		ImGui::HelpMarker("Comma separated offsets for variables reached through pointers, eg. \"0x10,8\" samples *(*(address) + 0x10) + 8. The address is the address of the root pointer. Leave empty for regular variables.");
+
 		/* POSTPROCESSING */
 		ImGui::Dummy(ImVec2(-1, 5));
 		GuiHelper::drawCenteredText("Postprocessing");
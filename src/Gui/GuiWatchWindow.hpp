@@ -0,0 +1,189 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "GuiHelper.hpp"
+#include "TraceDataHandler.hpp"
+#include "ViewerDataHandler.hpp"
+#include "WatchEngine.hpp"
+#include "imgui.h"
+
+class WatchWindow
+{
+   public:
+	WatchWindow(ViewerDataHandler* viewerDataHandler, TraceDataHandler* traceDataHandler) : viewerDataHandler(viewerDataHandler), traceDataHandler(traceDataHandler)
+	{
+	}
+
+	void draw(bool& show)
+	{
+		if (!show)
+			return;
+
+		if (ImGui::Begin("Watches", &show))
+		{
+			if (ImGui::BeginTabBar("##watchTabs"))
+			{
+				if (ImGui::BeginTabItem("Var Viewer"))
+				{
+					drawWatches(viewerDataHandler->getWatchEngine(), viewerDataHandler->getState() == DataHandlerBase::State::RUN, "variable");
+					ImGui::EndTabItem();
+				}
+				if (ImGui::BeginTabItem("Trace Viewer"))
+				{
+					drawWatches(traceDataHandler->getWatchEngine(), traceDataHandler->getState() == DataHandlerBase::State::RUN, "channel");
+					ImGui::EndTabItem();
+				}
+				ImGui::EndTabBar();
+			}
+		}
+		ImGui::End();
+	}
+
+   private:
+	void drawWatches(WatchEngine& engine, bool isRunning, const char* variableLabel)
+	{
+		auto watches = engine.getWatches();
+		bool modified = false;
+		int32_t toRemove = -1;
+
+		ImGui::BeginDisabled(isRunning);
+		static ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable;
+		if (ImGui::BeginTable("##watches", 9, flags))
+		{
+			ImGui::TableSetupColumn("on", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableSetupColumn("name");
+			ImGui::TableSetupColumn(variableLabel);
+			ImGui::TableSetupColumn("condition");
+			ImGui::TableSetupColumn("threshold");
+			ImGui::TableSetupColumn("hysteresis");
+			ImGui::TableSetupColumn("debounce");
+			ImGui::TableSetupColumn("stop", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableHeadersRow();
+
+			for (size_t i = 0; i < watches.size(); i++)
+			{
+				auto& watch = watches[i];
+				ImGui::PushID(static_cast<int>(i));
+				ImGui::TableNextRow();
+
+				ImGui::TableSetColumnIndex(0);
+				modified |= ImGui::Checkbox("##enabled", &watch.enabled);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::SetNextItemWidth(-1);
+				modified |= ImGui::InputText("##name", &watch.name, 0, NULL, NULL);
+				ImGui::TableSetColumnIndex(2);
+				ImGui::SetNextItemWidth(-1);
+				modified |= ImGui::InputText("##variable", &watch.variableName, 0, NULL, NULL);
+				ImGui::TableSetColumnIndex(3);
+				int32_t conditionCombo = static_cast<int32_t>(watch.condition);
+				ImGui::SetNextItemWidth(-1);
+				if (ImGui::Combo("##condition", &conditionCombo, WatchEngine::conditions, IM_ARRAYSIZE(WatchEngine::conditions)))
+				{
+					watch.condition = static_cast<WatchEngine::Condition>(conditionCombo);
+					modified = true;
+				}
+				if (watch.condition == WatchEngine::Condition::BITMASK)
+				{
+					ImGui::SetNextItemWidth(-1);
+					modified |= ImGui::InputScalar("##mask", ImGuiDataType_U32, &watch.mask, NULL, NULL, "0x%08x", ImGuiInputTextFlags_CharsHexadecimal);
+				}
+				ImGui::TableSetColumnIndex(4);
+				ImGui::SetNextItemWidth(-1);
+				modified |= ImGui::InputDouble("##threshold", &watch.threshold);
+				ImGui::TableSetColumnIndex(5);
+				ImGui::BeginDisabled(watch.condition != WatchEngine::Condition::GREATER && watch.condition != WatchEngine::Condition::LESS);
+				ImGui::SetNextItemWidth(-1);
+				modified |= ImGui::InputDouble("##hysteresis", &watch.hysteresis);
+				ImGui::EndDisabled();
+				ImGui::TableSetColumnIndex(6);
+				ImGui::SetNextItemWidth(-1);
+				modified |= ImGui::InputScalar("##debounce", ImGuiDataType_U32, &watch.debounceSamples, NULL, NULL, "%u");
+				ImGui::TableSetColumnIndex(7);
+				modified |= ImGui::Checkbox("##stop", &watch.stopAcquisition);
+				ImGui::TableSetColumnIndex(8);
+				if (ImGui::Button("x"))
+					toRemove = static_cast<int32_t>(i);
+
+				ImGui::PopID();
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::Button("Add watch"))
+		{
+			WatchEngine::Watch watch{};
+			watch.name = "watch" + std::to_string(watches.size());
+			watches.push_back(watch);
+			modified = true;
+		}
+		ImGui::SameLine();
+		ImGui::HelpMarker("Watches are evaluated on every sample of the acquisition. A hit is logged when the condition is met for the debounce number of consecutive samples, the watch is released when the value goes back past the hysteresis. Changes are applied on the next start.");
+		ImGui::EndDisabled();
+
+		if (toRemove >= 0)
+		{
+			watches.erase(watches.begin() + toRemove);
+			modified = true;
+		}
+
+		if (modified)
+			engine.setWatches(watches);
+
+		drawEvents(engine);
+	}
+
+	void drawEvents(WatchEngine& engine)
+	{
+		ImGui::Dummy(ImVec2(-1, 5));
+		GuiHelper::drawCenteredText("Events");
+		ImGui::Separator();
+
+		ImGui::Text("total: %llu", static_cast<unsigned long long>(engine.getEventCount()));
+		ImGui::SameLine();
+		if (ImGui::Button("Clear"))
+			engine.clearEvents();
+
+		auto events = engine.getEvents();
+
+		static ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (ImGui::BeginTable("##events", 4, flags))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("time [s]");
+			ImGui::TableSetupColumn("watch");
+			ImGui::TableSetupColumn("variable");
+			ImGui::TableSetupColumn("value");
+			ImGui::TableHeadersRow();
+
+			/* newest events on top */
+			for (auto it = events.rbegin(); it != events.rend(); ++it)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%.6f", it->timestamp);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%s", it->watchName.c_str());
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%s", it->variableName.c_str());
+				ImGui::TableSetColumnIndex(3);
+				ImGui::Text("%g", it->value);
+
+				if (ImGui::IsItemHovered() && !it->context.empty())
+				{
+					ImGui::BeginTooltip();
+					ImGui::PlotLines("##context", [](void* data, int idx)
+									 { return static_cast<float>((*static_cast<std::vector<double>*>(data))[idx]); },
+									 &it->context, static_cast<int>(it->context.size()), 0, "samples before the hit", FLT_MAX, FLT_MAX, ImVec2(250 * GuiHelper::contentScale, 80 * GuiHelper::contentScale));
+					ImGui::EndTooltip();
+				}
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	ViewerDataHandler* viewerDataHandler;
+	TraceDataHandler* traceDataHandler;
+};
@@ -0,0 +1,199 @@
+#include "Headless.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <thread>
+
+#include "GdbRemoteDebugProbe.hpp"
+#include "JlinkDebugProbe.hpp"
+#include "JlinkTraceProbe.hpp"
+#include "SimulatedDebugProbe.hpp"
+#include "StlinkDebugProbe.hpp"
+#include "StlinkTraceProbe.hpp"
+
+Headless::Headless(ConfigHandler* configHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, ViewerDataHandler* viewerDataHandler, TraceDataHandler* traceDataHandler, spdlog::logger* logger) : configHandler(configHandler), variableHandler(variableHandler), plotHandler(plotHandler), viewerDataHandler(viewerDataHandler), traceDataHandler(traceDataHandler), logger(logger)
+{
+}
+
+void Headless::signalHandler(int signal)
+{
+	interrupted = true;
+}
+
+int Headless::run(const Settings& settings)
+{
+	if (settings.projectPath.empty())
+	{
+		logger->error("Headless mode requires a project file (-p)!");
+		return 1;
+	}
+
+	if (!openProject(settings.projectPath))
+		return 1;
+
+	DataHandlerBase* dataHandler = nullptr;
+
+	if (settings.view == View::VAR_VIEWER)
+	{
+		if (!prepareViewer(settings))
+			return 1;
+		dataHandler = viewerDataHandler;
+	}
+	else
+	{
+		if (!prepareTrace(settings))
+			return 1;
+		dataHandler = traceDataHandler;
+	}
+
+	dataHandler->setLogFormat(settings.format);
+
+	interrupted = false;
+	std::signal(SIGINT, signalHandler);
+	std::signal(SIGTERM, signalHandler);
+
+	logger->info("Starting headless acquisition");
+	dataHandler->setState(DataHandlerBase::State::RUN);
+	waitForEnd(dataHandler, settings.durationS);
+
+	std::string error = dataHandler->getLastReaderError();
+	if (!error.empty())
+	{
+		logger->error("Acquisition stopped with error: {}", error);
+		return 1;
+	}
+
+	logger->info("Headless acquisition finished");
+	return 0;
+}
+
+bool Headless::openProject(const std::string& projectPath)
+{
+	if (!std::filesystem::exists(projectPath) || !configHandler->changeConfigFile(projectPath))
+	{
+		logger->error("Could not open project {}", projectPath);
+		return false;
+	}
+
+	std::string elfPath;
+	variableHandler->clear();
+	plotHandler->removeAllPlots();
+	configHandler->readConfigFile(elfPath);
+
+	logger->info("Project config path: {}", projectPath);
+	return true;
+}
+
+bool Headless::prepareViewer(const Settings& settings)
+{
+	auto probeSettings = viewerDataHandler->getProbeSettings();
+
+	if (probeSettings.debugProbe == 1)
+		debugProbe = std::make_shared<JlinkDebugProbe>(logger);
+	else if (probeSettings.debugProbe == 2)
+		debugProbe = std::make_shared<SimulatedDebugProbe>(logger);
+	else if (probeSettings.debugProbe == 3)
+		debugProbe = std::make_shared<GdbRemoteDebugProbe>(logger);
+	else
+		debugProbe = std::make_shared<StlinkDebugProbe>(logger);
+
+	/* the same choice the acquisition settings window makes when no S/N is stored */
+	if (probeSettings.serialNumber.empty())
+	{
+		auto devices = debugProbe->getConnectedDevices();
+		if (devices.empty())
+		{
+			logger->error("No debug probes found!");
+			return false;
+		}
+		probeSettings.serialNumber = devices.front();
+		viewerDataHandler->setProbeSettings(probeSettings);
+	}
+
+	viewerDataHandler->setDebugProbe(debugProbe);
+
+	auto viewerSettings = viewerDataHandler->getSettings();
+	viewerSettings.shouldLog = true;
+	if (!settings.outputDirectory.empty())
+		viewerSettings.logFilePath = settings.outputDirectory;
+
+	if (settings.untilTrigger)
+	{
+		if (viewerSettings.trigger.type == VariableTrigger::Type::DISABLED)
+		{
+			logger->error("The project has no trigger configured!");
+			return false;
+		}
+		viewerSettings.trigger.rearm = false;
+	}
+
+	viewerDataHandler->setSettings(viewerSettings);
+	return true;
+}
+
+bool Headless::prepareTrace(const Settings& settings)
+{
+	auto probeSettings = traceDataHandler->getProbeSettings();
+
+	if (probeSettings.debugProbe == 1)
+		traceProbe = std::make_shared<JlinkTraceProbe>(logger);
+	else
+		traceProbe = std::make_shared<StlinkTraceProbe>(logger);
+
+	if (probeSettings.serialNumber.empty())
+	{
+		auto devices = traceProbe->getConnectedDevices();
+		if (devices.empty())
+		{
+			logger->error("No debug probes found!");
+			return false;
+		}
+		probeSettings.serialNumber = devices.front();
+		traceDataHandler->setProbeSettings(probeSettings);
+	}
+
+	traceDataHandler->setDebugProbe(traceProbe);
+
+	auto traceSettings = traceDataHandler->getSettings();
+	traceSettings.shouldLog = true;
+	if (!settings.outputDirectory.empty())
+		traceSettings.logFilePath = settings.outputDirectory;
+
+	if (settings.untilTrigger && traceSettings.triggerChannel < 0)
+	{
+		logger->error("The project has no trace trigger channel configured!");
+		return false;
+	}
+
+	traceDataHandler->setSettings(traceSettings);
+	return true;
+}
+
+void Headless::waitForEnd(DataHandlerBase* dataHandler, double durationS)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	while (!interrupted)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(pollPeriodMs));
+
+		/* the handler stops on its own after a trigger, a stopping watch or a probe error */
+		if (dataHandler->getState() == DataHandlerBase::State::STOP)
+			return;
+
+		double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+		if (durationS > 0.0 && elapsed >= durationS)
+		{
+			logger->info("Acquisition time of {:.1f}s elapsed", durationS);
+			break;
+		}
+	}
+
+	if (interrupted)
+		logger->info("Interrupted, stopping acquisition");
+
+	dataHandler->setState(DataHandlerBase::State::STOP);
+	/* waits until the handler closes the probe and the log file */
+	dataHandler->getState();
+}
@@ -0,0 +1,70 @@
+#ifndef _HEADLESS_HPP
+#define _HEADLESS_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "CSVStreamer.hpp"
+#include "ConfigHandler.hpp"
+#include "IDebugProbe.hpp"
+#include "ITraceProbe.hpp"
+#include "TraceDataHandler.hpp"
+#include "VariableHandler.hpp"
+#include "ViewerDataHandler.hpp"
+#include "spdlog/spdlog.h"
+
+/* Runs a single acquisition of a saved project without creating a window or a graphics context.
+   The data is streamed with the handler's CSVStreamer, the acquisition ends after the duration, when the handler
+   stops on its own (trigger or watch) or on SIGINT/SIGTERM. */
+class Headless
+{
+   public:
+	enum class View : uint8_t
+	{
+		VAR_VIEWER = 0,
+		TRACE_VIEWER = 1,
+	};
+
+	struct Settings
+	{
+		std::string projectPath = "";
+		View view = View::VAR_VIEWER;
+		/* 0 means no time limit */
+		double durationS = 0.0;
+		/* stops after the post-trigger samples of the first trigger, the project must have a trigger configured */
+		bool untilTrigger = false;
+		CSVStreamer::Format format = CSVStreamer::Format::CSV;
+		/* empty keeps the log directory of the project */
+		std::string outputDirectory = "";
+	};
+
+	Headless(ConfigHandler* configHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, ViewerDataHandler* viewerDataHandler, TraceDataHandler* traceDataHandler, spdlog::logger* logger);
+
+	/* returns the process exit code */
+	int run(const Settings& settings);
+
+   private:
+	bool openProject(const std::string& projectPath);
+	bool prepareViewer(const Settings& settings);
+	bool prepareTrace(const Settings& settings);
+	void waitForEnd(DataHandlerBase* dataHandler, double durationS);
+
+	static void signalHandler(int signal);
+
+	static constexpr uint32_t pollPeriodMs = 50;
+	static inline std::atomic<bool> interrupted = false;
+
+	ConfigHandler* configHandler;
+	VariableHandler* variableHandler;
+	PlotHandler* plotHandler;
+	ViewerDataHandler* viewerDataHandler;
+	TraceDataHandler* traceDataHandler;
+	spdlog::logger* logger;
+
+	std::shared_ptr<IDebugProbe> debugProbe;
+	std::shared_ptr<ITraceProbe> traceProbe;
+};
+
+#endif
@@ -0,0 +1,568 @@
+#include "GdbRemoteDebugProbe.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/* a server closing the connection must not raise SIGPIPE and terminate the application, sendRaw reports the error instead */
+#ifdef MSG_NOSIGNAL
+static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int sendFlags = 0;
+#endif
+
+GdbRemoteDebugProbe::GdbRemoteDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+#ifdef _WIN32
+	WSADATA wsaData;
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+}
+
+GdbRemoteDebugProbe::~GdbRemoteDebugProbe()
+{
+	disconnect();
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+bool GdbRemoteDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	lastErrorMsg = "";
+	isRunning = false;
+
+	if (probeSettings.mode == Mode::HSS)
+	{
+		lastErrorMsg = "HSS mode is not supported by the GDB server probe!";
+		logger->error(lastErrorMsg);
+		return false;
+	}
+
+	if (socketHandle != invalidSocket && (probeSettings.serialNumber != sessionServer || !isSessionAlive()))
+	{
+		logger->info("GDB server session cannot be reused, reconnecting");
+		closeSocket();
+	}
+
+	if (socketHandle != invalidSocket)
+	{
+		isRunning = true;
+		return true;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (!connectSocket(probeSettings.serialNumber))
+		return false;
+
+	if (!handshake())
+	{
+		closeSocket();
+		return false;
+	}
+
+	sessionServer = probeSettings.serialNumber;
+	lastErrorMsg = "";
+	logger->info("Connected to GDB server {} in {} ms (no-ack: {}, non-stop: {}, packet size: {})", probeSettings.serialNumber, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), noAck, nonStop, maxPacketSize);
+	isRunning = true;
+	return true;
+}
+
+bool GdbRemoteDebugProbe::stopAcqusition()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	isRunning = false;
+	return true;
+}
+
+void GdbRemoteDebugProbe::disconnect()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	/* detaching leaves the target running */
+	std::string reply;
+	if (socketHandle != invalidSocket)
+		transact("D", reply);
+
+	isRunning = false;
+	closeSocket();
+}
+
+bool GdbRemoteDebugProbe::isSessionAlive()
+{
+	/* any reply, even an empty one for an unsupported packet, means the server is still there */
+	std::string reply;
+	return transact("qAttached", reply);
+}
+
+bool GdbRemoteDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+bool GdbRemoteDebugProbe::connectSocket(const std::string& server)
+{
+	std::string host = server;
+	std::string port = std::to_string(defaultPort);
+
+	auto separator = server.rfind(':');
+	if (separator != std::string::npos)
+	{
+		host = server.substr(0, separator);
+		port = server.substr(separator + 1);
+	}
+
+	if (host.empty())
+		host = "localhost";
+
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* addresses = nullptr;
+
+	if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+	{
+		fail("Could not resolve GDB server " + server);
+		return false;
+	}
+
+	for (addrinfo* address = addresses; address != nullptr; address = address->ai_next)
+	{
+		socketHandle = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+		if (socketHandle == invalidSocket)
+			continue;
+
+		if (connect(socketHandle, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0)
+			break;
+
+		closeSocket();
+	}
+	freeaddrinfo(addresses);
+
+	if (socketHandle == invalidSocket)
+	{
+		fail("Could not connect to GDB server " + server);
+		return false;
+	}
+
+	/* requests are small and latency bound */
+	int flag = 1;
+	setsockopt(socketHandle, IPPROTO_TCP, TCP_NODELAY, (const char*)&flag, sizeof(flag));
+#ifdef SO_NOSIGPIPE
+	/* macOS has no MSG_NOSIGNAL, the socket option does the same */
+	setsockopt(socketHandle, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&flag, sizeof(flag));
+#endif
+
+	noAck = false;
+	nonStop = false;
+	maxPacketSize = defaultPacketSize;
+	rxOffset = 0;
+	rxSize = 0;
+	return true;
+}
+
+void GdbRemoteDebugProbe::closeSocket()
+{
+	if (socketHandle == invalidSocket)
+		return;
+
+#ifdef _WIN32
+	closesocket(socketHandle);
+#else
+	close(socketHandle);
+#endif
+	socketHandle = invalidSocket;
+}
+
+bool GdbRemoteDebugProbe::handshake()
+{
+	std::string reply;
+
+	/* acknowledges anything the server might have sent on connect */
+	if (!sendRaw("+", 1) || !transact("qSupported:multiprocess-;swbreak+;hwbreak+", reply))
+		return false;
+
+	bool supportsNoAck = false;
+	bool supportsNonStop = false;
+
+	size_t begin = 0;
+	while (begin < reply.size())
+	{
+		size_t end = reply.find(';', begin);
+		if (end == std::string::npos)
+			end = reply.size();
+		std::string feature = reply.substr(begin, end - begin);
+		begin = end + 1;
+
+		if (feature == "QStartNoAckMode+")
+			supportsNoAck = true;
+		else if (feature == "QNonStop+")
+			supportsNonStop = true;
+		else if (feature.rfind("PacketSize=", 0) == 0)
+		{
+			size_t size = 0;
+			std::from_chars(feature.data() + 11, feature.data() + feature.size(), size, 16);
+			if (size > readRequestOverhead)
+				maxPacketSize = size;
+		}
+	}
+
+	/* the reply to QStartNoAckMode is still acknowledged */
+	if (supportsNoAck && transact("QStartNoAckMode", reply) && reply == "OK")
+		noAck = true;
+	else
+		logger->warn("GDB server does not support the no-ack mode, memory packets will not be pipelined");
+
+	/* in the all-stop mode the server does not accept memory packets while the target runs */
+	if (supportsNonStop && transact("QNonStop:1", reply) && reply == "OK")
+	{
+		nonStop = true;
+
+		if (!transact("?", reply))
+			return false;
+
+		/* every stopped thread is reported once, the list ends with OK */
+		bool isHalted = false;
+		while (reply != "OK" && !reply.empty() && reply[0] != 'E')
+		{
+			isHalted = true;
+			if (!transact("vStopped", reply))
+				return false;
+		}
+
+		if (isHalted)
+		{
+			logger->info("Target halted by the GDB server, resuming");
+			if (!transact("vCont;c", reply) || reply != "OK")
+				logger->warn("Could not resume the target: {}", reply);
+		}
+	}
+	else if (transact("?", reply) && !reply.empty() && (reply[0] == 'S' || reply[0] == 'T'))
+		logger->warn("GDB server runs in all-stop mode and the target is halted, sampled values will not change");
+
+	return socketHandle != invalidSocket;
+}
+
+bool GdbRemoteDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	/* single word reads write the whole word into the buffer, like the other probes do */
+	if (size <= sizeof(uint32_t))
+		std::memset(buf, 0, sizeof(uint32_t));
+
+	currentOperation = ProbeStatistics::Operation::READ_MEMORY;
+	const auto start = ProbeStatistics::Clock::now();
+	bool result = readChunks(address, buf, size);
+	statistics.record(currentOperation, start, result);
+	return result;
+}
+
+bool GdbRemoteDebugProbe::readChunks(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	const uint32_t maxChunk = (maxPacketSize - readRequestOverhead) / 2;
+	size_t packets = 0;
+
+	for (uint32_t offset = 0; offset < size; offset += maxChunk)
+	{
+		const uint32_t length = std::min(maxChunk, size - offset);
+		queuePacket(fmt::format("m{:x},{:x}", address + offset, length));
+		packets++;
+	}
+
+	if (!flush(packets))
+		return false;
+
+	for (size_t i = 0; i < packets; i++)
+	{
+		const uint32_t offset = i * maxChunk;
+		if (!decodeHex(replies[i], buf + offset, std::min(maxChunk, size - offset)))
+			return false;
+	}
+	return true;
+}
+
+bool GdbRemoteDebugProbe::readMemoryBatch(std::span<const std::pair<uint32_t, uint8_t>> reads, uint32_t* values)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	currentOperation = ProbeStatistics::Operation::READ_BATCH;
+	const auto start = ProbeStatistics::Clock::now();
+
+	for (auto [address, size] : reads)
+		queuePacket(fmt::format("m{:x},{:x}", address, size));
+
+	bool result = flush(reads.size());
+
+	for (size_t i = 0; result && i < reads.size(); i++)
+	{
+		values[i] = 0;
+		result = decodeHex(replies[i], (uint8_t*)&values[i], std::min<uint32_t>(reads[i].second, sizeof(uint32_t)));
+	}
+
+	statistics.record(currentOperation, start, result);
+	return result;
+}
+
+bool GdbRemoteDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	std::string payload = fmt::format("M{:x},{:x}:", address, size);
+	for (uint32_t i = 0; i < size; i++)
+		payload += fmt::format("{:02x}", buf[i]);
+
+	currentOperation = ProbeStatistics::Operation::WRITE_MEMORY;
+	const auto start = ProbeStatistics::Clock::now();
+	std::string reply;
+	bool result = transact(payload, reply) && reply == "OK";
+	statistics.record(currentOperation, start, result);
+	return result;
+}
+
+void GdbRemoteDebugProbe::queuePacket(const std::string& payload)
+{
+	uint8_t checksum = 0;
+	for (char c : payload)
+		checksum += static_cast<uint8_t>(c);
+
+	txBuffer += '$';
+	txBuffer += payload;
+	txBuffer += fmt::format("#{:02x}", checksum);
+}
+
+bool GdbRemoteDebugProbe::flush(size_t packets)
+{
+	replies.resize(std::max(replies.size(), packets));
+
+	/* without the no-ack mode every packet has to be acknowledged before the next one is sent */
+	if (!noAck)
+	{
+		size_t begin = 0;
+		for (size_t i = 0; i < packets; i++)
+		{
+			size_t end = txBuffer.find('#', begin) + 3;
+			char ack = 0;
+
+			/* a '-' asks for the packet again */
+			for (uint32_t attempt = 0; attempt <= maxRetransmissions && ack != '+'; attempt++)
+			{
+				if (attempt > 0)
+					statistics.addRetry(currentOperation);
+
+				if (!sendRaw(txBuffer.data() + begin, end - begin) || !readByte(ack))
+				{
+					txBuffer.clear();
+					return false;
+				}
+			}
+
+			if (ack != '+' || !receivePacket(replies[i]))
+			{
+				txBuffer.clear();
+				return false;
+			}
+			begin = end;
+		}
+		txBuffer.clear();
+		return true;
+	}
+
+	bool result = sendRaw(txBuffer.data(), txBuffer.size());
+	txBuffer.clear();
+
+	for (size_t i = 0; result && i < packets; i++)
+		result = receivePacket(replies[i]);
+
+	return result;
+}
+
+bool GdbRemoteDebugProbe::transact(const std::string& payload, std::string& reply)
+{
+	queuePacket(payload);
+	if (!flush(1))
+		return false;
+
+	reply = replies[0];
+	return true;
+}
+
+bool GdbRemoteDebugProbe::receivePacket(std::string& payload)
+{
+	while (true)
+	{
+		char c = 0;
+
+		/* acknowledgements and anything else before the start of a packet are skipped */
+		do
+		{
+			if (!readByte(c))
+				return false;
+		} while (c != '$' && c != '%');
+
+		const bool isNotification = c == '%';
+		uint8_t checksum = 0;
+		payload.clear();
+
+		while (true)
+		{
+			if (!readByte(c))
+				return false;
+			if (c == '#')
+				break;
+
+			checksum += static_cast<uint8_t>(c);
+
+			/* run length encoding - the previous character is repeated (count - 29) times */
+			if (c == '*' && !payload.empty())
+			{
+				char count = 0;
+				if (!readByte(count))
+					return false;
+				checksum += static_cast<uint8_t>(count);
+				payload.append(std::max(0, count - 29), payload.back());
+				continue;
+			}
+			payload.push_back(c);
+		}
+
+		char checksumHex[2];
+		if (!readByte(checksumHex[0]) || !readByte(checksumHex[1]))
+			return false;
+
+		uint8_t received = 0;
+		std::from_chars(checksumHex, checksumHex + 2, received, 16);
+
+		if (received != checksum)
+		{
+			if (noAck)
+			{
+				fail("GDB server packet checksum error!");
+				return false;
+			}
+			statistics.addRetry(currentOperation);
+			sendRaw("-", 1);
+			continue;
+		}
+
+		if (!noAck)
+			sendRaw("+", 1);
+
+		/* asynchronous stop notifications of the non-stop mode are not used */
+		if (isNotification)
+			continue;
+
+		return true;
+	}
+}
+
+bool GdbRemoteDebugProbe::sendRaw(const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		auto sent = send(socketHandle, data, static_cast<int>(size), sendFlags);
+		if (sent <= 0)
+		{
+			fail("GDB server connection lost!");
+			return false;
+		}
+		data += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+bool GdbRemoteDebugProbe::readByte(char& c)
+{
+	if (rxOffset < rxSize)
+	{
+		c = rxBuffer[rxOffset++];
+		return true;
+	}
+
+	pollfd descriptor{};
+	descriptor.fd = socketHandle;
+	descriptor.events = POLLIN;
+
+#ifdef _WIN32
+	int ready = WSAPoll(&descriptor, 1, receiveTimeoutMs);
+#else
+	int ready = poll(&descriptor, 1, receiveTimeoutMs);
+#endif
+
+	if (ready <= 0)
+	{
+		fail("GDB server timeout!");
+		return false;
+	}
+
+	auto received = recv(socketHandle, rxBuffer.data(), static_cast<int>(rxBuffer.size()), 0);
+	if (received <= 0)
+	{
+		fail("GDB server connection lost!");
+		return false;
+	}
+
+	rxSize = received;
+	rxOffset = 0;
+	c = rxBuffer[rxOffset++];
+	return true;
+}
+
+bool GdbRemoteDebugProbe::decodeHex(const std::string& hex, uint8_t* buf, uint32_t size)
+{
+	if (hex.size() < size * 2)
+	{
+		lastErrorMsg = hex.size() == 3 && hex[0] == 'E' ? "GDB server memory read error " + hex : "GDB server memory read error!";
+		return false;
+	}
+
+	for (uint32_t i = 0; i < size; i++)
+	{
+		auto result = std::from_chars(hex.data() + 2 * i, hex.data() + 2 * i + 2, buf[i], 16);
+		if (result.ec != std::errc())
+		{
+			lastErrorMsg = "GDB server sent an invalid memory reply!";
+			return false;
+		}
+	}
+	return true;
+}
+
+void GdbRemoteDebugProbe::fail(const std::string& message)
+{
+	lastErrorMsg = message;
+	logger->error(lastErrorMsg);
+	isRunning = false;
+}
+
+std::string GdbRemoteDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> GdbRemoteDebugProbe::getConnectedDevices()
+{
+	/* OpenOCD and pyOCD, J-Link GDB server, QEMU */
+	return {"localhost:3333", "localhost:2331", "localhost:1234"};
+}
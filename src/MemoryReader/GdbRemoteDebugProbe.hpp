@@ -0,0 +1,96 @@
+#ifndef _GdbRemoteDebugProbe_HPP
+#define _GdbRemoteDebugProbe_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#endif
+
+/* Debug probe backed by any gdbserver (OpenOCD, pyOCD, J-Link GDB server, QEMU gdbstub) over the GDB Remote
+   Serial Protocol. The server address is taken from the serial number field as "host:port". When the server
+   supports the no-ack mode, all memory packets of a sample tick are sent at once and the replies are read back
+   in order, so a tick costs a single round trip regardless of the number of variables. */
+class GdbRemoteDebugProbe : public IDebugProbe
+{
+   public:
+	GdbRemoteDebugProbe(spdlog::logger* logger);
+	~GdbRemoteDebugProbe();
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	void disconnect() override;
+	bool isValid() const override;
+	std::string getTargetName() override { return std::string(); }
+
+	/* HSS is not available over RSP, the probe is used in NORMAL mode only */
+	size_t readEntries(std::span<Frame> frames) override { return 0; }
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::span<const std::pair<uint32_t, uint8_t>> reads, uint32_t* values) override;
+
+	std::string getLastErrorMsg() const override;
+	/* default ports of the common servers, any "host:port" can be entered instead */
+	std::vector<std::string> getConnectedDevices() override;
+
+	static constexpr uint16_t defaultPort = 3333;
+
+   private:
+#ifdef _WIN32
+	using Socket = SOCKET;
+	static constexpr Socket invalidSocket = INVALID_SOCKET;
+#else
+	using Socket = int;
+	static constexpr Socket invalidSocket = -1;
+#endif
+
+	bool connectSocket(const std::string& server);
+	void closeSocket();
+	bool handshake();
+	bool isSessionAlive();
+
+	/* frames the payload as $payload#cs and appends it to the transmit buffer */
+	void queuePacket(const std::string& payload);
+	/* sends the transmit buffer and reads one reply per queued packet */
+	bool flush(size_t packets);
+	bool transact(const std::string& payload, std::string& reply);
+	bool receivePacket(std::string& payload);
+	bool sendRaw(const char* data, size_t size);
+	bool readByte(char& c);
+
+	bool readChunks(uint32_t address, uint8_t* buf, uint32_t size);
+	bool decodeHex(const std::string& hex, uint8_t* buf, uint32_t size);
+	void fail(const std::string& message);
+
+	static constexpr uint32_t receiveTimeoutMs = 1000;
+	static constexpr uint32_t maxRetransmissions = 3;
+	static constexpr size_t defaultPacketSize = 1024;
+	/* $m + 8 hex digits of address + , + length + #cs */
+	static constexpr size_t readRequestOverhead = 24;
+
+	Socket socketHandle = invalidSocket;
+	std::string sessionServer;
+	bool noAck = false;
+	bool nonStop = false;
+	size_t maxPacketSize = defaultPacketSize;
+
+	std::string txBuffer;
+	std::vector<char> rxBuffer = std::vector<char>(4096);
+	size_t rxOffset = 0;
+	size_t rxSize = 0;
+	std::vector<std::string> replies;
+	/* the retransmissions are counted as retries of the operation in progress */
+	ProbeStatistics::Operation currentOperation = ProbeStatistics::Operation::READ_MEMORY;
+
+	spdlog::logger* logger;
+};
+
+#endif
@@ -3,13 +3,13 @@
 
 #include <atomic>
 #include <cstdint>
-#include <optional>
+#include <mutex>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "RingBuffer.hpp"
+#include "ProbeStatistics.hpp"
 
 class IDebugProbe
 {
@@ -30,28 +30,60 @@ class IDebugProbe
 
 	} DebugProbeSettings;
 
-	/* timestamp (first) and a map of <address-value> entries (second) only fo HSS mode */
-	using varEntryType = std::pair<double, std::unordered_map<uint32_t, double>>;
+	/* single HSS tick, values are in the order of the sample list given to startAcqusition or updateSampleList */
+	struct Frame
+	{
+		double timestamp = 0.0;
+		std::vector<uint32_t> values;
+	};
 
 	virtual ~IDebugProbe() = default;
+	/* the probe session is kept open between acquisitions - start reuses it when the settings did not change and
+	   the target still responds, otherwise it reconnects. Stop only ends the sampling */
 	virtual bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) = 0;
 	virtual bool stopAcqusition() = 0;
+	/* closes the kept session, e.g. before another probe or the trace viewer takes over the device */
+	virtual void disconnect() {}
 	virtual bool isValid() const = 0;
 	virtual std::string getTargetName() = 0;
 
-	/* only HSS mode */
-	virtual std::optional<varEntryType> readSingleEntry() = 0;
+	/* changes the sampled addresses of a running acquisition without reconnecting */
+	virtual bool updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+	{
+		return true;
+	}
+
+	/* only HSS mode - decodes all ticks available at once, up to frames.size(), and returns the number of filled frames.
+	   The values vectors are resized in place so the frames should be reused between calls */
+	virtual size_t readEntries(std::span<Frame> frames) = 0;
 
 	/* NORMAL mode */
 	virtual bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) = 0;
 	virtual bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) = 0;
 
+	/* NORMAL mode - reads all words of a sample tick, values are zero extended to 32 bits.
+	   Probes that can have multiple requests in flight override it to read the whole tick in a single round trip */
+	virtual bool readMemoryBatch(std::span<const std::pair<uint32_t, uint8_t>> reads, uint32_t* values)
+	{
+		for (size_t i = 0; i < reads.size(); i++)
+		{
+			values[i] = 0;
+			if (!readMemory(reads[i].first, (uint8_t*)&values[i], reads[i].second))
+				return false;
+		}
+		return true;
+	}
+
 	virtual std::string getLastErrorMsg() const = 0;
 
 	virtual std::vector<std::string> getConnectedDevices() = 0;
 
+	/* per-call latency, failures and retries of the probe operations */
+	ProbeStatistics& getStatistics() { return statistics; }
+
    protected:
 	std::atomic<bool> isRunning = false;
+	ProbeStatistics statistics;
 	std::string lastErrorMsg = "";
 	mutable std::mutex mtx;
 };
@@ -4,20 +4,51 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 JlinkDebugProbe::JlinkDebugProbe(spdlog::logger* logger) : logger(logger)
 {
 }
 
+JlinkDebugProbe::~JlinkDebugProbe()
+{
+	disconnect();
+}
+
 bool JlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	int serialNumberInt = std::atoi(probeSettings.serialNumber.c_str());
 	lastErrorMsg = "";
 	isRunning = false;
 	emptyMessageErrorCnt = 0;
 
+	if (isSessionOpen && (probeSettings.serialNumber != sessionSerialNumber || probeSettings.device != sessionDevice || probeSettings.speedkHz != sessionSpeedkHz || !isSessionAlive()))
+	{
+		logger->info("J-Link session cannot be reused, reconnecting");
+		closeSession();
+	}
+
+	if (!isSessionOpen && !openSession(probeSettings))
+		return false;
+
+	mode = probeSettings.mode;
+
+	if (probeSettings.mode == IDebugProbe::Mode::NORMAL)
+	{
+		isRunning = true;
+		return true;
+	}
+
+	startHss(addressSizeVector, samplingFreqency);
+	return isRunning;
+}
+
+bool JlinkDebugProbe::openSession(const DebugProbeSettings& probeSettings)
+{
+	auto start = std::chrono::steady_clock::now();
+	int serialNumberInt = std::atoi(probeSettings.serialNumber.c_str());
+
 	if (JLINKARM_EMU_SelectByUSBSN(serialNumberInt) < 0)
 	{
 		lastErrorMsg = "Could not connect to the selected probe";
@@ -49,49 +80,96 @@ bool JlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, s
 		lastErrorMsg = "Could not connect to the target!";
 		logger->error(lastErrorMsg);
 		JLINKARM_Close();
-		return isRunning;
+		return false;
 	}
 
-	if (probeSettings.mode == IDebugProbe::Mode::NORMAL)
-	{
-		isRunning = true;
-		return true;
-	}
+	isSessionOpen = true;
+	sessionSerialNumber = probeSettings.serialNumber;
+	sessionDevice = probeSettings.device;
+	sessionSpeedkHz = probeSettings.speedkHz;
+	logger->info("J-Link connected in {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+	return true;
+}
 
-	if (varTable.size() > 0)
-		varTable.clear();
+void JlinkDebugProbe::closeSession()
+{
+	if (!isSessionOpen)
+		return;
 
-	trackedVarsCount = 0;
+	JLINKARM_Close();
+	isSessionOpen = false;
+}
 
-	/* account for timestamp in size */
-	trackedVarsTotalSize = sizeof(uint32_t);
-	for (auto [address, size] : addressSizeVector)
+bool JlinkDebugProbe::isSessionAlive()
+{
+	/* a debug register read fails when the probe or the target was unplugged in the meantime */
+	uint32_t dhcsr = 0;
+	return JLINKARM_IsOpen() && JLINKARM_ReadMemEx(dhcsrAddress, sizeof(dhcsr), &dhcsr, 0) >= 0;
+}
+
+bool JlinkDebugProbe::updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	if (mode == IDebugProbe::Mode::NORMAL)
+		return true;
+
+	/* HSS is reconfigured in place - the connection to the target is kept */
+	JLINK_HSS_Stop();
+	emptyMessageErrorCnt = 0;
+
+	if (!startHss(addressSizeVector, samplingFreqency))
 	{
-		auto& desc = variableDesc[trackedVarsCount++];
-		desc.Addr = address;
-		desc.NumBytes = size;
-		desc.Flags = 0;
-		desc.Dummy = 0;
-		addressSizeMap[address] = size;
-		trackedVarsTotalSize += size;
+		closeSession();
+		return false;
 	}
 
+	logger->info("J-Link HSS restarted with {} variables", trackedVarsCount);
+	return true;
+}
+
+bool JlinkDebugProbe::startHss(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
 	if (samplingFreqency < 1)
 		samplingFreqency = 1;
 
 	uint32_t samplePeriodUs = 1.0 / (samplingFreqency * timestampResolution);
-	int32_t result = JLINK_HSS_Start(variableDesc, trackedVarsCount, samplePeriodUs, JLINK_HSS_FLAG_TIMESTAMP_US);
 	/* 1M is arbitraty value that works across all sampling frequencies */
 	emptyMessageErrorThreshold = 1.0 / (timestampResolution * samplingFreqency) * 1000000;
 
-	if (result >= 0)
-		isRunning = true;
-	else
+	size_t count = std::min(addressSizeVector.size(), maxVariables);
+	int32_t result = startHssWithCount(addressSizeVector, count, samplePeriodUs);
+
+	/* the probe limit depends on the variable sizes and the sampling period, so the largest fitting
+	   prefix of the sample list is searched for - the first variables are the ones sampled by HSS */
+	if (result == -3 && count > 1)
 	{
-		JLINKARM_Close();
-		isRunning = false;
+		size_t low = 1;
+		size_t high = count - 1;
+		size_t fits = 0;
+
+		while (low <= high)
+		{
+			size_t mid = (low + high) / 2;
+			result = startHssWithCount(addressSizeVector, mid, samplePeriodUs);
+			if (result >= 0)
+			{
+				fits = mid;
+				JLINK_HSS_Stop();
+				low = mid + 1;
+			}
+			else if (result == -3)
+				high = mid - 1;
+			else
+				break;
+		}
+
+		if (fits > 0)
+			result = startHssWithCount(addressSizeVector, fits, samplePeriodUs);
 	}
 
+	isRunning = result >= 0;
+
 	if (result == -1)
 		logger->error("Unspecified J-Link error!");
 	else if (result == -2)
@@ -107,16 +185,136 @@ bool JlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, s
 		logger->error(lastErrorMsg);
 	}
 
-	return isRunning;
+	if (!isRunning)
+		return false;
+
+	preparePolledVariables(addressSizeVector, trackedVarsCount);
+	polledPeriod = std::chrono::microseconds(std::max(samplePeriodUs, minPolledPeriodUs));
+
+	if (!polledVariables.empty())
+	{
+		logger->warn("HSS set split: {} variables sampled by HSS at {} Hz, {} variables polled in {} blocks at up to {:.0f} Hz", trackedVarsCount, samplingFreqency, polledVariables.size(), polledBlocks.size(), 1.0e6 / polledPeriod.count());
+		readPolledVariables();
+	}
+
+	return true;
+}
+
+int32_t JlinkDebugProbe::startHssWithCount(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, size_t count, uint32_t samplePeriodUs)
+{
+	trackedVarsCount = 0;
+
+	/* account for timestamp in size */
+	trackedVarsTotalSize = sizeof(uint32_t);
+	for (size_t i = 0; i < count; i++)
+	{
+		auto [address, size] = addressSizeVector[i];
+		variableOffsets[trackedVarsCount] = trackedVarsTotalSize;
+		auto& desc = variableDesc[trackedVarsCount++];
+		desc.Addr = address;
+		desc.NumBytes = size;
+		desc.Flags = 0;
+		desc.Dummy = 0;
+		trackedVarsTotalSize += size;
+	}
+
+	return JLINK_HSS_Start(variableDesc, trackedVarsCount, samplePeriodUs, JLINK_HSS_FLAG_TIMESTAMP_US);
+}
+
+void JlinkDebugProbe::preparePolledVariables(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, size_t first)
+{
+	polledVariables.clear();
+	polledBlocks.clear();
+
+	for (size_t i = first; i < addressSizeVector.size(); i++)
+		polledVariables.push_back({addressSizeVector[i].first, addressSizeVector[i].second, 0, 0});
+
+	polledValues.assign(polledVariables.size(), 0);
+
+	/* blocks are built in address order, the variables keep their sample list order */
+	std::vector<size_t> order(polledVariables.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+			  { return polledVariables[a].address < polledVariables[b].address; });
+
+	uint32_t maxBlock = 0;
+	for (auto i : order)
+	{
+		auto& variable = polledVariables[i];
+		uint32_t end = variable.address + variable.size;
+
+		if (!polledBlocks.empty())
+		{
+			auto& block = polledBlocks.back();
+			uint32_t blockEnd = block.address + block.size;
+			if (variable.address <= blockEnd + maxPolledBlockGap && std::max(end, blockEnd) - block.address <= maxPolledBlockSize)
+			{
+				block.size = std::max(end, blockEnd) - block.address;
+				variable.block = polledBlocks.size() - 1;
+				variable.offset = variable.address - block.address;
+				maxBlock = std::max(maxBlock, block.size);
+				continue;
+			}
+		}
+
+		polledBlocks.push_back({variable.address, variable.size});
+		variable.block = polledBlocks.size() - 1;
+		variable.offset = 0;
+		maxBlock = std::max(maxBlock, static_cast<uint32_t>(variable.size));
+	}
+
+	polledBuffer.resize(maxBlock);
+}
+
+void JlinkDebugProbe::readPolledVariables()
+{
+	lastPoll = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < polledBlocks.size(); i++)
+	{
+		auto& block = polledBlocks[i];
+		const auto start = ProbeStatistics::Clock::now();
+		const bool result = JLINKARM_ReadMemEx(block.address, block.size, polledBuffer.data(), 0) >= 0;
+		statistics.record(ProbeStatistics::Operation::READ_BATCH, start, result);
+
+		/* on a failed read the previous values are held */
+		if (!result)
+			continue;
+
+		for (size_t j = 0; j < polledVariables.size(); j++)
+		{
+			auto& variable = polledVariables[j];
+			if (variable.block != i)
+				continue;
+
+			uint32_t value = 0;
+			std::memcpy(&value, polledBuffer.data() + variable.offset, variable.size);
+			polledValues[j] = value;
+		}
+	}
 }
 
 bool JlinkDebugProbe::stopAcqusition()
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	JLINKARM_Close();
+	if (mode == IDebugProbe::Mode::HSS && isSessionOpen)
+		JLINK_HSS_Stop();
+
+	isRunning = false;
 	return true;
 }
 
+void JlinkDebugProbe::disconnect()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (mode == IDebugProbe::Mode::HSS && isSessionOpen)
+		JLINK_HSS_Stop();
+
+	isRunning = false;
+	closeSession();
+}
+
 bool JlinkDebugProbe::isValid() const
 {
 	return isRunning;
@@ -136,12 +334,18 @@ std::string JlinkDebugProbe::getTargetName()
 	return devInfo.sName ? std::string(devInfo.sName) : std::string();
 }
 
-std::optional<IDebugProbe::varEntryType> JlinkDebugProbe::readSingleEntry()
+size_t JlinkDebugProbe::readEntries(std::span<Frame> frames)
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	uint8_t rawBuffer[bufferSizeHSS]{};
 
-	int32_t readSize = JLINK_HSS_Read(rawBuffer, sizeof(rawBuffer));
+	/* only as many records as there are frames are read, the rest stays in the probe buffer */
+	const size_t maxRecords = std::min(frames.size(), bufferSizeHSS / trackedVarsTotalSize);
+	if (maxRecords == 0)
+		return 0;
+
+	const auto start = ProbeStatistics::Clock::now();
+	int32_t readSize = JLINK_HSS_Read(rawBuffer.data(), maxRecords * trackedVarsTotalSize);
+	statistics.record(ProbeStatistics::Operation::READ_ENTRIES, start, readSize >= 0);
 
 	if (readSize <= 0)
 	{
@@ -152,47 +356,60 @@ std::optional<IDebugProbe::varEntryType> JlinkDebugProbe::readSingleEntry()
 			logger->error(lastErrorMsg);
 			isRunning = false;
 		}
-		return varTable.pop();
+		return 0;
 	}
 
 	emptyMessageErrorCnt = 0;
 
-	for (int32_t i = 0; i < readSize; i += trackedVarsTotalSize)
+	if (!polledVariables.empty() && std::chrono::steady_clock::now() - lastPoll >= polledPeriod)
+		readPolledVariables();
+
+	const size_t records = static_cast<size_t>(readSize) / trackedVarsTotalSize;
+	for (size_t i = 0; i < records; i++)
 	{
-		varEntryType entry{};
+		const uint8_t* record = rawBuffer.data() + i * trackedVarsTotalSize;
+		Frame& frame = frames[i];
 
-		/* timestamp */
-		entry.first = (*(uint32_t*)&rawBuffer[i]) * timestampResolution;
+		uint32_t timestamp = 0;
+		std::memcpy(&timestamp, record, sizeof(uint32_t));
+		frame.timestamp = timestamp * timestampResolution;
 
-		int32_t k = i + 4;
+		frame.values.resize(trackedVarsCount + polledValues.size());
 		for (size_t j = 0; j < trackedVarsCount; j++)
 		{
-			uint32_t address = variableDesc[j].Addr;
-			entry.second[address] = *(uint32_t*)&rawBuffer[k];
-			k += addressSizeMap[address];
-		}
-
-		if (!varTable.push(entry))
-		{
-			lastErrorMsg = "HSS FIFO overflow!";
-			logger->error(lastErrorMsg);
-			isRunning = false;
+			uint32_t value = 0;
+			std::memcpy(&value, record + variableOffsets[j], variableDesc[j].NumBytes);
+			frame.values[j] = value;
 		}
+		/* the polled values are merged onto the HSS time base */
+		std::copy(polledValues.begin(), polledValues.end(), frame.values.begin() + trackedVarsCount);
 	}
 
-	return varTable.pop();
+	return records;
 }
 
 bool JlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	return (isRunning && JLINKARM_ReadMemEx(address, size, buf, 0) >= 0);
+	if (!isRunning)
+		return false;
+
+	const auto start = ProbeStatistics::Clock::now();
+	bool result = JLINKARM_ReadMemEx(address, size, buf, 0) >= 0;
+	statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, result);
+	return result;
 }
 
 bool JlinkDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	return (isRunning && JLINKARM_WriteMemEx(address, size, buf, 0) >= 0);
+	if (!isRunning)
+		return false;
+
+	const auto start = ProbeStatistics::Clock::now();
+	bool result = JLINKARM_WriteMemEx(address, size, buf, 0) >= 0;
+	statistics.record(ProbeStatistics::Operation::WRITE_MEMORY, start, result);
+	return result;
 }
 
 std::string JlinkDebugProbe::getLastErrorMsg() const
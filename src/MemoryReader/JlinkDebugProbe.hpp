@@ -1,9 +1,10 @@
 #ifndef _JlinkDebugProbe_HPP
 #define _JlinkDebugProbe_HPP
 
+#include <chrono>
 #include <mutex>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "IDebugProbe.hpp"
@@ -14,12 +15,15 @@ class JlinkDebugProbe : public IDebugProbe
 {
    public:
 	JlinkDebugProbe(spdlog::logger* logger);
+	~JlinkDebugProbe();
 	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
 	bool stopAcqusition() override;
+	void disconnect() override;
+	bool updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
 	bool isValid() const override;
 	std::string getTargetName() override;
 
-	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+	size_t readEntries(std::span<Frame> frames) override;
 
 	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
 	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
@@ -28,22 +32,66 @@ class JlinkDebugProbe : public IDebugProbe
 	std::vector<std::string> getConnectedDevices() override;
 
    private:
+	/* variable that did not fit into the HSS set, read with JLINKARM_ReadMemEx as a part of a block */
+	struct PolledVariable
+	{
+		uint32_t address;
+		uint8_t size;
+		size_t block;
+		uint32_t offset;
+	};
+
+	struct PolledBlock
+	{
+		uint32_t address;
+		uint32_t size;
+	};
+
+	bool openSession(const DebugProbeSettings& probeSettings);
+	void closeSession();
+	bool isSessionAlive();
+
+	bool startHss(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency);
+	int32_t startHssWithCount(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, size_t count, uint32_t samplePeriodUs);
+	void preparePolledVariables(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, size_t first);
+	void readPolledVariables();
+
 	static constexpr size_t maxDevices = 10;
 	static constexpr size_t maxVariables = 100;
-	static constexpr size_t fifoSize = 2000;
 	static constexpr uint32_t maxSpeedkHz = 50000;
 	static constexpr double timestampResolution = 1e-6;
 	static constexpr uint32_t bufferSizeHSS = 16384;
+	static constexpr uint32_t dhcsrAddress = 0xE000EDF0;
+	/* polled variables closer than this are read in a single block */
+	static constexpr uint32_t maxPolledBlockGap = 32;
+	static constexpr uint32_t maxPolledBlockSize = 1024;
+	static constexpr uint32_t minPolledPeriodUs = 10000;
 
 	JLINK_HSS_MEM_BLOCK_DESC variableDesc[maxVariables]{};
+	/* offset of every variable in an HSS record, the record starts with the timestamp */
+	uint32_t variableOffsets[maxVariables]{};
 	size_t trackedVarsCount = 0;
+	Mode mode = Mode::NORMAL;
 	size_t trackedVarsTotalSize = 0;
 
+	/* settings the open session was created with */
+	bool isSessionOpen = false;
+	std::string sessionSerialNumber;
+	std::string sessionDevice;
+	uint32_t sessionSpeedkHz = 0;
+
 	size_t emptyMessageErrorThreshold = 100000;
 	size_t emptyMessageErrorCnt = 0;
 
-	std::unordered_map<uint32_t, uint8_t> addressSizeMap;
-	RingBuffer<varEntryType, fifoSize> varTable;
+	std::vector<uint8_t> rawBuffer = std::vector<uint8_t>(bufferSizeHSS);
+
+	/* overflow set - its last values are held in every frame until the next poll */
+	std::vector<PolledVariable> polledVariables;
+	std::vector<PolledBlock> polledBlocks;
+	std::vector<uint32_t> polledValues;
+	std::vector<uint8_t> polledBuffer;
+	std::chrono::microseconds polledPeriod{minPolledPeriodUs};
+	std::chrono::steady_clock::time_point lastPoll{};
 
 	spdlog::logger* logger;
 };
@@ -0,0 +1,304 @@
+#include "SimulatedDebugProbe.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+SimulatedDebugProbe::SimulatedDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+}
+
+bool SimulatedDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	lastErrorMsg = "";
+	mode = probeSettings.mode;
+	rng.seed(settings.seed);
+	transactions = 0;
+	injectedErrors = 0;
+	start = std::chrono::steady_clock::now();
+
+	prepareSampleList(addressSizeVector, samplingFreqency);
+
+	logger->info("Simulated probe started with {} variables, {} driven by generators", sampleList.size(), activeSignals.size());
+	isRunning = true;
+	return true;
+}
+
+bool SimulatedDebugProbe::stopAcqusition()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	isRunning = false;
+
+	if (injectedErrors > 0)
+		logger->info("Simulated probe: {} transactions, {} errors injected", transactions.load(), injectedErrors.load());
+	return true;
+}
+
+bool SimulatedDebugProbe::updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	prepareSampleList(addressSizeVector, samplingFreqency);
+	return isRunning;
+}
+
+void SimulatedDebugProbe::prepareSampleList(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	sampleList = addressSizeVector;
+	activeSignals = signals;
+	sampleSignals.assign(sampleList.size(), -1);
+
+	for (size_t i = 0; i < sampleList.size(); i++)
+	{
+		auto [address, size] = sampleList[i];
+		auto it = std::find_if(activeSignals.begin(), activeSignals.end(), [&](const Signal& signal)
+							   { return signal.address == address; });
+
+		if (it == activeSignals.end() && settings.autoSignals)
+		{
+			/* spreads the generator types and frequencies over the sampled variables */
+			Signal signal{};
+			signal.address = address;
+			signal.size = size;
+			signal.generator = static_cast<Generator>(1 + (address / 4) % 4);
+			signal.amplitude = 100.0;
+			signal.frequencyHz = 1.0 + (address / 4) % 10;
+			activeSignals.push_back(signal);
+			it = activeSignals.end() - 1;
+		}
+
+		if (it != activeSignals.end())
+			sampleSignals[i] = static_cast<int32_t>(it - activeSignals.begin());
+	}
+
+	/* the HSS time base restarts with the new list */
+	samplingPeriod = 1.0 / std::max(samplingFreqency, 1u);
+	producedTicks = 0;
+	start = std::chrono::steady_clock::now();
+}
+
+bool SimulatedDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+size_t SimulatedDebugProbe::readEntries(std::span<Frame> frames)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning || frames.empty())
+		return 0;
+
+	const auto start = ProbeStatistics::Clock::now();
+	if (!transaction())
+	{
+		statistics.record(ProbeStatistics::Operation::READ_ENTRIES, start, false);
+		return 0;
+	}
+
+	/* every tick that elapsed since the last read is produced, the timestamps are exact multiples of the period */
+	const uint64_t elapsedTicks = static_cast<uint64_t>(getTime() / samplingPeriod) + 1;
+	const size_t count = std::min<uint64_t>(elapsedTicks - producedTicks, frames.size());
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Frame& frame = frames[i];
+		frame.timestamp = (producedTicks + i) * samplingPeriod;
+		frame.values.resize(sampleList.size());
+
+		for (size_t j = 0; j < sampleList.size(); j++)
+			frame.values[j] = sample(j, frame.timestamp);
+	}
+
+	producedTicks += count;
+	statistics.record(ProbeStatistics::Operation::READ_ENTRIES, start, true);
+	return count;
+}
+
+bool SimulatedDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	const auto start = ProbeStatistics::Clock::now();
+	if (!transaction())
+	{
+		statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, false);
+		return false;
+	}
+
+	applySignals(address, size, getTime());
+
+	/* single word reads write the whole word into the buffer, like the hardware probes do */
+	if (size <= sizeof(uint32_t))
+	{
+		uint32_t value = 0;
+		readImage(address, (uint8_t*)&value, size);
+		std::memcpy(buf, &value, sizeof(uint32_t));
+	}
+	else
+		readImage(address, buf, size);
+
+	statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, true);
+	return true;
+}
+
+bool SimulatedDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	const auto start = ProbeStatistics::Clock::now();
+	bool result = transaction();
+	if (result)
+		writeImage(address, buf, size);
+
+	statistics.record(ProbeStatistics::Operation::WRITE_MEMORY, start, result);
+	return result;
+}
+
+std::string SimulatedDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> SimulatedDebugProbe::getConnectedDevices()
+{
+	return {serialNumber};
+}
+
+void SimulatedDebugProbe::setSettings(const Settings& newSettings)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	settings = newSettings;
+	settings.errorRate = std::clamp(settings.errorRate, 0.0, 1.0);
+}
+
+SimulatedDebugProbe::Settings SimulatedDebugProbe::getSettings() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return settings;
+}
+
+void SimulatedDebugProbe::setSignals(const std::vector<Signal>& newSignals)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	signals = newSignals;
+}
+
+std::vector<SimulatedDebugProbe::Signal> SimulatedDebugProbe::getSignals() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return signals;
+}
+
+bool SimulatedDebugProbe::transaction()
+{
+	transactions++;
+
+	if (settings.latencyUs > 0)
+	{
+		/* sleeping is not accurate enough for microsecond latencies */
+		const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(settings.latencyUs);
+		while (std::chrono::steady_clock::now() < end)
+		{
+		}
+	}
+
+	if (settings.errorRate > 0.0 && uniform(rng) < settings.errorRate)
+	{
+		injectedErrors++;
+		lastErrorMsg = "Simulated transaction error!";
+		return false;
+	}
+	return true;
+}
+
+double SimulatedDebugProbe::evaluate(const Signal& signal, double time)
+{
+	/* the epsilon keeps exact multiples of the period from landing on the previous step */
+	const double cycles = time * signal.frequencyHz + 1e-9;
+
+	switch (signal.generator)
+	{
+		case Generator::SINE:
+			return signal.offset + signal.amplitude * std::sin(2.0 * std::numbers::pi * time * signal.frequencyHz);
+		case Generator::NOISE:
+			return signal.offset + signal.amplitude * (2.0 * uniform(rng) - 1.0);
+		case Generator::COUNTER:
+			return signal.offset + signal.amplitude * std::floor(cycles);
+		case Generator::STEP:
+			return signal.offset + (static_cast<uint64_t>(2.0 * cycles) % 2 ? signal.amplitude : 0.0);
+		case Generator::CONSTANT:
+		default:
+			return signal.offset;
+	}
+}
+
+uint32_t SimulatedDebugProbe::sample(size_t index, double time)
+{
+	auto [address, size] = sampleList[index];
+	uint8_t buf[sizeof(uint64_t)]{};
+
+	if (sampleSignals[index] >= 0)
+		encode(activeSignals[sampleSignals[index]], evaluate(activeSignals[sampleSignals[index]], time), buf);
+	else
+		readImage(address, buf, std::min<uint32_t>(size, sizeof(uint32_t)));
+
+	uint32_t value = 0;
+	std::memcpy(&value, buf, std::min<uint32_t>(size, sizeof(uint32_t)));
+	return value;
+}
+
+void SimulatedDebugProbe::applySignals(uint32_t address, uint32_t size, double time)
+{
+	for (auto& signal : activeSignals)
+	{
+		if (signal.address >= address + size || signal.address + signal.size <= address)
+			continue;
+
+		uint8_t buf[sizeof(uint64_t)]{};
+		encode(signal, evaluate(signal, time), buf);
+		writeImage(signal.address, buf, std::min<uint32_t>(signal.size, sizeof(buf)));
+	}
+}
+
+void SimulatedDebugProbe::encode(const Signal& signal, double value, uint8_t* buf)
+{
+	if (signal.encoding == Encoding::FLOAT && signal.size == sizeof(float))
+	{
+		float floatValue = static_cast<float>(value);
+		std::memcpy(buf, &floatValue, sizeof(float));
+	}
+	else if (signal.encoding == Encoding::FLOAT && signal.size == sizeof(double))
+		std::memcpy(buf, &value, sizeof(double));
+	else
+	{
+		/* two's complement, truncated to the variable size by the caller */
+		int64_t integerValue = static_cast<int64_t>(std::llround(value));
+		std::memcpy(buf, &integerValue, sizeof(int64_t));
+	}
+}
+
+void SimulatedDebugProbe::writeImage(uint32_t address, const uint8_t* buf, uint32_t size)
+{
+	for (uint32_t i = 0; i < size; i++)
+		pages[(address + i) / pageSize][(address + i) % pageSize] = buf[i];
+}
+
+void SimulatedDebugProbe::readImage(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	/* memory that was never written reads as zeros */
+	for (uint32_t i = 0; i < size; i++)
+	{
+		auto it = pages.find((address + i) / pageSize);
+		buf[i] = it == pages.end() ? 0 : it->second[(address + i) % pageSize];
+	}
+}
+
+double SimulatedDebugProbe::getTime() const
+{
+	return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,126 @@
+#ifndef _SimulatedDebugProbe_HPP
+#define _SimulatedDebugProbe_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/* In-process virtual target for load testing without hardware. The target is a sparse RAM image, the sampled
+   addresses are driven by signal generators. HSS ticks are produced on demand from the elapsed time so that
+   sampling frequencies up to 1 MHz can be served without a sampling thread. */
+class SimulatedDebugProbe : public IDebugProbe
+{
+   public:
+	enum class Generator : uint8_t
+	{
+		CONSTANT = 0,
+		SINE = 1,
+		NOISE = 2,
+		COUNTER = 3,
+		STEP = 4,
+	};
+
+	enum class Encoding : uint8_t
+	{
+		INTEGER = 0,
+		/* float for 4 byte variables, double for 8 byte ones */
+		FLOAT = 1,
+	};
+
+	struct Signal
+	{
+		uint32_t address = 0;
+		uint8_t size = 4;
+		Generator generator = Generator::SINE;
+		Encoding encoding = Encoding::INTEGER;
+		double amplitude = 1.0;
+		double offset = 0.0;
+		/* period of the sine and the step, increment rate of the counter */
+		double frequencyHz = 1.0;
+	};
+
+	struct Settings
+	{
+		/* busy waited on every transaction, a bulk HSS read counts as a single transaction */
+		uint32_t latencyUs = 0;
+		/* probability of a failed transaction */
+		double errorRate = 0.0;
+		/* sampled addresses without a configured signal get a generator derived from their address */
+		bool autoSignals = true;
+		uint32_t seed = 0;
+	};
+
+	SimulatedDebugProbe(spdlog::logger* logger);
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool isValid() const override;
+	std::string getTargetName() override { return "Simulated target"; }
+
+	size_t readEntries(std::span<Frame> frames) override;
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+
+	std::string getLastErrorMsg() const override;
+	std::vector<std::string> getConnectedDevices() override;
+
+	void setSettings(const Settings& newSettings);
+	Settings getSettings() const;
+
+	/* signals replace the RAM image contents at their addresses, they are applied on the next start */
+	void setSignals(const std::vector<Signal>& newSignals);
+	std::vector<Signal> getSignals() const;
+
+	uint64_t getTransactionCount() const { return transactions; }
+	uint64_t getInjectedErrorCount() const { return injectedErrors; }
+
+	static constexpr const char* serialNumber = "SIMULATED";
+
+   private:
+	static constexpr uint32_t pageSize = 1024;
+
+	void prepareSampleList(const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency);
+	/* returns false when an error was injected */
+	bool transaction();
+	double evaluate(const Signal& signal, double time);
+	uint32_t sample(size_t index, double time);
+	void applySignals(uint32_t address, uint32_t size, double time);
+	void writeImage(uint32_t address, const uint8_t* buf, uint32_t size);
+	void readImage(uint32_t address, uint8_t* buf, uint32_t size);
+	void encode(const Signal& signal, double value, uint8_t* buf);
+	double getTime() const;
+
+	Settings settings{};
+	std::vector<Signal> signals;
+	std::unordered_map<uint32_t, std::array<uint8_t, pageSize>> pages;
+
+	Mode mode = Mode::NORMAL;
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+	/* signal driving every sample list entry, -1 for plain memory */
+	std::vector<int32_t> sampleSignals;
+	/* configured signals followed by the generated ones */
+	std::vector<Signal> activeSignals;
+	std::chrono::steady_clock::time_point start{};
+	double samplingPeriod = 1.0;
+	uint64_t producedTicks = 0;
+
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> uniform{0.0, 1.0};
+	std::atomic<uint64_t> transactions = 0;
+	std::atomic<uint64_t> injectedErrors = 0;
+
+	spdlog::logger* logger;
+};
+
+#endif
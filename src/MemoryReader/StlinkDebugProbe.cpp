@@ -13,45 +13,228 @@ StlinkDebugProbe::StlinkDebugProbe(spdlog::logger* logger) : logger(logger)
 	// init_chipids(const_cast<char*>("./chips"));
 }
 
+StlinkDebugProbe::~StlinkDebugProbe()
+{
+	disconnect();
+}
+
 bool StlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
 {
 	std::lock_guard<std::mutex> lock(mtx);
-	sl = stlink_open_usb(UINFO, CONNECT_HOT_PLUG, (char*)probeSettings.serialNumber.data(), probeSettings.speedkHz);
 	isRunning = false;
 
-	if (sl != nullptr)
+	if (sl != nullptr && (probeSettings.serialNumber != sessionSerialNumber || probeSettings.speedkHz != sessionSpeedkHz || !isSessionAlive()))
 	{
-		if (stlink_enter_swd_mode(sl) != 0 || stlink_target_connect(sl, CONNECT_HOT_PLUG) != 0)
-		{
-			isRunning = false;
-			stlink_close(sl);
-			lastErrorMsg = "STM32 target not found!";
-			return false;
-		}
+		logger->info("STLink session cannot be reused, reconnecting");
+		closeSession();
+	}
 
-		isRunning = true;
-		lastErrorMsg = "";
-		return true;
+	if (sl == nullptr && !openSession(probeSettings))
+		return false;
+
+	isRunning = true;
+	lastErrorMsg = "";
+	mode = probeSettings.mode;
+	samplingStart = std::chrono::steady_clock::now();
+
+	if (mode == Mode::HSS)
+		startSampling(addressSizeVector, samplingFreqency);
+	return true;
+}
+
+bool StlinkDebugProbe::openSession(const DebugProbeSettings& probeSettings)
+{
+	std::lock_guard<std::mutex> usbLock(usbMtx);
+	auto start = std::chrono::steady_clock::now();
+	sl = stlink_open_usb(UINFO, CONNECT_HOT_PLUG, (char*)probeSettings.serialNumber.data(), probeSettings.speedkHz);
+
+	if (sl == nullptr)
+	{
+		lastErrorMsg = "STLink not found!";
+		return false;
 	}
-	lastErrorMsg = "STLink not found!";
-	return false;
+
+	if (stlink_enter_swd_mode(sl) != 0 || stlink_target_connect(sl, CONNECT_HOT_PLUG) != 0)
+	{
+		stlink_close(sl);
+		sl = nullptr;
+		lastErrorMsg = "STM32 target not found!";
+		return false;
+	}
+
+	sessionSerialNumber = probeSettings.serialNumber;
+	sessionSpeedkHz = probeSettings.speedkHz;
+	logger->info("STLink connected in {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+	return true;
 }
+
+void StlinkDebugProbe::closeSession()
+{
+	if (sl == nullptr)
+		return;
+
+	std::lock_guard<std::mutex> usbLock(usbMtx);
+	stlink_close(sl);
+	sl = nullptr;
+}
+
+bool StlinkDebugProbe::isSessionAlive()
+{
+	/* a debug register read fails when the probe or the target was unplugged in the meantime */
+	uint32_t dhcsr = 0;
+	return stlink_read_debug32(sl, STLINK_REG_DHCSR, &dhcsr) == 0;
+}
+
 bool StlinkDebugProbe::stopAcqusition()
 {
+	/* the sampling thread takes the mutex on every tick so it has to be stopped first */
+	stopSampling();
+
 	std::lock_guard<std::mutex> lock(mtx);
 	isRunning = false;
-	stlink_close(sl);
 	return true;
 }
+
+void StlinkDebugProbe::disconnect()
+{
+	stopSampling();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	isRunning = false;
+	closeSession();
+}
+
+bool StlinkDebugProbe::updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	if (mode == Mode::NORMAL)
+		return true;
+
+	/* the connection is kept, only the sampling thread is restarted with the new list */
+	stopSampling();
+	startSampling(addressSizeVector, samplingFreqency);
+	logger->info("STLink sampling restarted with {} variables", sampleList.size());
+	return isValid();
+}
+
+void StlinkDebugProbe::startSampling(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	sampleList.clear();
+	for (auto& entry : addressSizeVector)
+	{
+		if (sampleList.size() >= maxVariables)
+		{
+			logger->warn("Too many variables for STLink HSS mode, only first {} will be sampled", maxVariables);
+			break;
+		}
+		sampleList.push_back(entry);
+	}
+
+	/* entries of the previous sample list are not valid anymore */
+	while (entries->front() != nullptr)
+		entries->popFront();
+
+	samplingPeriod = std::chrono::nanoseconds(1000000000 / std::max(samplingFreqency, 1u));
+	droppedEntries = 0;
+	missedTicks = 0;
+	isSampling = true;
+	samplingHandle = std::thread(&StlinkDebugProbe::samplingThread, this);
+}
+
+void StlinkDebugProbe::stopSampling()
+{
+	isSampling = false;
+	if (!samplingHandle.joinable())
+		return;
+
+	samplingHandle.join();
+
+	if (droppedEntries > 0 || missedTicks > 0)
+		logger->warn("STLink sampling: {} entries dropped, {} ticks missed", droppedEntries.load(), missedTicks.load());
+}
+
+void StlinkDebugProbe::samplingThread()
+{
+	uint64_t tick = 0;
+	const auto tickStart = std::chrono::steady_clock::now();
+
+	while (isSampling)
+	{
+		const auto scheduled = tickStart + tick * samplingPeriod;
+		auto now = std::chrono::steady_clock::now();
+
+		if (now < scheduled)
+		{
+			if (scheduled - now > spinThreshold)
+				std::this_thread::sleep_for(scheduled - now - spinThreshold);
+			else
+				std::this_thread::yield();
+			continue;
+		}
+
+		/* late by more than a period - the missed ticks are skipped instead of being read back-to-back */
+		const uint64_t late = (now - scheduled) / samplingPeriod;
+		missedTicks += late;
+		tick += late + 1;
+
+		/* the consumer is too slow - the tick is skipped, the thread never waits for it */
+		Entry* entry = entries->getWriteSlot();
+		if (entry == nullptr)
+		{
+			droppedEntries++;
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			if (!isRunning)
+				return;
+
+			entry->timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(now - samplingStart).count();
+			entry->count = sampleList.size();
+
+			/* the whole tick is one batch, its latency is the USB round trips of all sampled words */
+			const auto start = ProbeStatistics::Clock::now();
+			for (size_t i = 0; i < sampleList.size(); i++)
+			{
+				auto [address, size] = sampleList[i];
+				if (!readWord(address, (uint8_t*)&entry->values[i], size))
+				{
+					statistics.record(ProbeStatistics::Operation::READ_BATCH, start, false);
+					lastErrorMsg = "STLink read error!";
+					logger->error(lastErrorMsg);
+					isRunning = false;
+					return;
+				}
+			}
+			statistics.record(ProbeStatistics::Operation::READ_BATCH, start, true);
+		}
+
+		entries->commitWrite();
+	}
+}
 bool StlinkDebugProbe::isValid() const
 {
 	std::lock_guard<std::mutex> lock(mtx);
 	return isRunning;
 }
 
-std::optional<IDebugProbe::varEntryType> StlinkDebugProbe::readSingleEntry()
+size_t StlinkDebugProbe::readEntries(std::span<Frame> frames)
 {
-	return std::nullopt;
+	const auto start = ProbeStatistics::Clock::now();
+	size_t count = 0;
+
+	for (; count < frames.size(); count++)
+	{
+		Entry* entry = entries->front();
+		if (entry == nullptr)
+			break;
+
+		frames[count].timestamp = entry->timestamp;
+		frames[count].values.assign(entry->values.begin(), entry->values.begin() + entry->count);
+		entries->popFront();
+	}
+	statistics.record(ProbeStatistics::Operation::READ_ENTRIES, start, true);
+	return count;
 }
 
 bool StlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
@@ -60,6 +243,18 @@ bool StlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 	if (!isRunning)
 		return false;
 
+	const auto start = ProbeStatistics::Clock::now();
+	/* readWord shifts within a single debug word, reads crossing into the next word go through the block path */
+	const bool isWordRead = (size == 1 || size == 2 || size == 4) && address % 4 + size <= 4;
+	if (!isWordRead && size < sizeof(uint32_t))
+		std::fill(buf, buf + sizeof(uint32_t), 0);
+	bool result = isWordRead ? readWord(address, buf, size) : readMemoryBlock(address, buf, size);
+	statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, result);
+	return result;
+}
+
+bool StlinkDebugProbe::readWord(uint32_t address, uint8_t* buf, uint32_t size)
+{
 	uint32_t valueRaw = 0;
 	uint8_t shouldShift = address % 4;
 
@@ -100,13 +295,37 @@ bool StlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 	}
 	return result;
 }
+
+bool StlinkDebugProbe::readMemoryBlock(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	/* 32-bit block transfers have to be word aligned, the unaligned head and tail are cut off after the read */
+	const uint32_t end = address + size;
+	const uint32_t alignedEnd = (end + 3) & ~3u;
+
+	for (uint32_t chunkAddress = address & ~3u; chunkAddress < alignedEnd; chunkAddress += maxBlockTransferSize)
+	{
+		const uint32_t length = std::min(maxBlockTransferSize, alignedEnd - chunkAddress);
+
+		if (stlink_read_mem32(sl, chunkAddress, static_cast<uint16_t>(length)) != 0)
+			return false;
+
+		const uint32_t first = std::max(chunkAddress, address);
+		const uint32_t last = std::min(chunkAddress + length, end);
+		std::copy(sl->q_buf + (first - chunkAddress), sl->q_buf + (last - chunkAddress), buf + (first - address));
+	}
+	return true;
+}
+
 bool StlinkDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
 {
 	std::lock_guard<std::mutex> lock(mtx);
 	if (!isRunning)
 		return false;
+	const auto start = ProbeStatistics::Clock::now();
 	std::copy(buf, buf + size, sl->q_buf);
-	return stlink_write_mem8(sl, address, size) == 0;
+	bool result = stlink_write_mem8(sl, address, size) == 0;
+	statistics.record(ProbeStatistics::Operation::WRITE_MEMORY, start, result);
+	return result;
 }
 
 std::string StlinkDebugProbe::getLastErrorMsg() const
@@ -116,7 +335,8 @@ std::string StlinkDebugProbe::getLastErrorMsg() const
 
 std::vector<std::string> StlinkDebugProbe::getConnectedDevices()
 {
-	std::lock_guard<std::mutex> lock(mtx);
+	/* runs without the probe lock so that it never stalls sampling, usbMtx keeps the session from being opened or closed meanwhile */
+	std::lock_guard<std::mutex> usbLock(usbMtx);
 	stlink_t** stdevs;
 	uint32_t size;
 
@@ -137,5 +357,13 @@ std::vector<std::string> StlinkDebugProbe::getConnectedDevices()
 
 	stlink_probe_usb_free(&stdevs, size);
 
+	/* a probe claimed by a kept session may not be listed by the enumeration */
+	if (sl != nullptr)
+	{
+		std::string serialNumber{sl->serial};
+		if (!serialNumber.empty() && std::find(deviceIDs.begin(), deviceIDs.end(), serialNumber) == deviceIDs.end())
+			deviceIDs.push_back(serialNumber);
+	}
+
 	return deviceIDs;
 }
\ No newline at end of file
@@ -1,11 +1,17 @@
 #ifndef _StlinkDebugProbe_HPP
 #define _StlinkDebugProbe_HPP
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "IDebugProbe.hpp"
+#include "RingBufferLockFree.hpp"
 #include "stlink.h"
 
 #include "spdlog/spdlog.h"
@@ -14,12 +20,15 @@ class StlinkDebugProbe : public IDebugProbe
 {
    public:
 	StlinkDebugProbe(spdlog::logger* logger);
+	~StlinkDebugProbe();
 	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
 	bool stopAcqusition() override;
+	void disconnect() override;
+	bool updateSampleList(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
 	bool isValid() const override;
 	std::string getTargetName() override { return std::string(); }
 
-	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+	size_t readEntries(std::span<Frame> frames) override;
 	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
 	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
 
@@ -27,7 +36,52 @@ class StlinkDebugProbe : public IDebugProbe
 	std::vector<std::string> getConnectedDevices() override;
 
    private:
+	/* raw values of a single sampling thread tick in the sample list order */
+	struct Entry
+	{
+		double timestamp;
+		uint32_t count;
+		std::array<uint32_t, 100> values;
+	};
+
+	bool openSession(const DebugProbeSettings& probeSettings);
+	void closeSession();
+	bool isSessionAlive();
+
+	/* reads of arrays and structures larger than a single word */
+	bool readMemoryBlock(uint32_t address, uint8_t* buf, uint32_t size);
+	bool readWord(uint32_t address, uint8_t* buf, uint32_t size);
+
+	/* HSS mode - the sample list is read on every tick by a dedicated thread, the entries are consumed with readEntries */
+	void startSampling(std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency);
+	void stopSampling();
+	void samplingThread();
+
+	static constexpr uint32_t maxBlockTransferSize = 1024;
+	static constexpr size_t maxVariables = std::tuple_size<decltype(Entry::values)>::value;
+	static constexpr size_t fifoSize = 4096;
+	/* ticks closer than this are waited for by yielding instead of sleeping to keep the period regular */
+	static constexpr std::chrono::microseconds spinThreshold{500};
+
+	/* USB enumeration is serialized with opening and closing the sessions of all instances (the viewer and the trace probe),
+	   it is taken after mtx and never held while sampling so the enumeration does not stall the acquisition */
+	static inline std::mutex usbMtx;
+
 	stlink_t* sl = nullptr;
+	/* settings the open session was created with */
+	std::string sessionSerialNumber;
+	uint32_t sessionSpeedkHz = 0;
+	Mode mode = Mode::NORMAL;
+
+	std::thread samplingHandle;
+	std::atomic<bool> isSampling = false;
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+	std::chrono::nanoseconds samplingPeriod{};
+	std::chrono::steady_clock::time_point samplingStart;
+	std::atomic<uint64_t> droppedEntries = 0;
+	std::atomic<uint64_t> missedTicks = 0;
+	std::unique_ptr<RingBufferLockFree<Entry, fifoSize>> entries = std::make_unique<RingBufferLockFree<Entry, fifoSize>>();
+
 	spdlog::logger* logger;
 };
 
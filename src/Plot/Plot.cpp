@@ -2,6 +2,7 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <bitset>
 #include <limits>
 #include <sstream>
@@ -46,6 +47,11 @@ bool Plot::addSeries(Variable* var)
 	seriesMap[name] = std::make_shared<Series>();
 	seriesMap[name]->buffer = std::make_unique<ScrollingBuffer<double>>();
 	seriesMap[name]->var = var;
+	seriesMap[name]->decimatedBuffer = std::make_unique<DecimatingBuffer<double>>();
+	seriesMap[name]->decimatedBuffer->setFactor(decimationFactor);
+	seriesMap[name]->decimatedBuffer->setMaxSize(decimatedMaxPoints);
+	seriesMap[name]->frames.setPersistence(arrayPersistence);
+	seriesMap[name]->frames.setAveraging(arrayAveraging);
 	return true;
 }
 
@@ -136,6 +142,12 @@ void Plot::updateSeries()
 bool Plot::addTimePoint(double t)
 {
 	time.addPoint(t);
+
+	/* series are updated before the time point so their newest values belong to t */
+	if (decimationFactor > 0)
+		for (auto& [name, ser] : seriesMap)
+			ser->decimatedBuffer->addPoint(t, ser->buffer->getNewestValue());
+
 	return true;
 }
 
@@ -145,7 +157,11 @@ void Plot::erase()
 	xAxisSeries.buffer->erase();
 
 	for (auto& [name, ser] : seriesMap)
+	{
 		ser->buffer->erase();
+		ser->decimatedBuffer->erase();
+		ser->frames.erase();
+	}
 }
 
 void Plot::setVisibility(bool state)
@@ -170,6 +186,88 @@ Plot::Type Plot::getType() const
 	return type;
 }
 
+void Plot::setArrayLength(uint32_t length)
+{
+	arrayLength = std::max(1u, length);
+}
+
+uint32_t Plot::getArrayLength() const
+{
+	return arrayLength;
+}
+
+void Plot::setArrayPersistence(uint32_t frames)
+{
+	arrayPersistence = std::max(1u, frames);
+	for (auto& [name, ser] : seriesMap)
+		ser->frames.setPersistence(arrayPersistence);
+}
+
+uint32_t Plot::getArrayPersistence() const
+{
+	return arrayPersistence;
+}
+
+void Plot::setArrayAveraging(uint32_t frames)
+{
+	arrayAveraging = std::max(1u, frames);
+	for (auto& [name, ser] : seriesMap)
+		ser->frames.setAveraging(arrayAveraging);
+}
+
+uint32_t Plot::getArrayAveraging() const
+{
+	return arrayAveraging;
+}
+
+void Plot::setDecimationFactor(uint32_t factor)
+{
+	if (factor == decimationFactor)
+		return;
+
+	decimationFactor = factor;
+	for (auto& [name, ser] : seriesMap)
+		ser->decimatedBuffer->setFactor(decimationFactor);
+}
+
+uint32_t Plot::getDecimationFactor() const
+{
+	return decimationFactor;
+}
+
+void Plot::setDecimatedMaxPoints(uint32_t maxPoints)
+{
+	if (maxPoints == decimatedMaxPoints)
+		return;
+
+	decimatedMaxPoints = maxPoints;
+	for (auto& [name, ser] : seriesMap)
+		ser->decimatedBuffer->setMaxSize(decimatedMaxPoints);
+}
+
+uint32_t Plot::getDecimatedMaxPoints() const
+{
+	return decimatedMaxPoints;
+}
+
+void Plot::setDecimationMode(DecimationMode mode)
+{
+	decimationMode = mode;
+}
+
+Plot::DecimationMode Plot::getDecimationMode() const
+{
+	return decimationMode;
+}
+
+void Plot::addArrayFrame(const std::string& name, const std::vector<double>& frame)
+{
+	if (!seriesMap.contains(name))
+		return;
+
+	seriesMap.at(name)->frames.addFrame(frame);
+}
+
 void Plot::setDomain(Domain newDomain)
 {
 	domain = newDomain;
@@ -272,3 +370,13 @@ void Plot::setXAxisVariable(Variable* var)
 {
 	xAxisSeries.var = var;
 }
+
+void Plot::setSampleFrequency(uint32_t frequencyHz)
+{
+	sampleFrequencyHz = frequencyHz;
+}
+
+uint32_t Plot::getSampleFrequency() const
+{
+	return sampleFrequencyHz;
+}
@@ -9,6 +9,8 @@
 #include <thread>
 #include <vector>
 
+#include "DecimatingBuffer.hpp"
+#include "FrameBuffer.hpp"
 #include "ScrollingBuffer.hpp"
 #include "Variable.hpp"
 
@@ -26,6 +28,10 @@ class Plot
 		Variable* var = nullptr;
 		displayFormat format = displayFormat::DEC;
 		std::unique_ptr<ScrollingBuffer<double>> buffer;
+		/* min/max/mean history filled when the plot decimation is enabled */
+		std::unique_ptr<DecimatingBuffer<double>> decimatedBuffer;
+		/* snapshots of the whole array, used by ARRAY plots only */
+		FrameBuffer<double> frames;
 		bool visible = true;
 
 		void addPointFromVar() { buffer->addPoint(var->getValue()); }
@@ -36,7 +42,16 @@ class Plot
 		CURVE = 0,
 		BAR = 1,
 		TABLE = 2,
-		XY = 3
+		XY = 3,
+		ARRAY = 4
+	};
+
+	/* how the decimated history is drawn */
+	enum class DecimationMode : uint8_t
+	{
+		ENVELOPE = 0,
+		AVERAGE = 1,
+		PEAK_HOLD = 2,
 	};
 
 	enum class Domain : uint8_t
@@ -141,6 +156,29 @@ class Plot
 	Variable* getXAxisVariable();
 	void setXAxisVariable(Variable* var);
 
+	/* 0 means the plot is sampled with the acquisition sampling frequency */
+	void setSampleFrequency(uint32_t frequencyHz);
+	uint32_t getSampleFrequency() const;
+
+	/* number of elements read from the series address on every ARRAY plot tick */
+	void setArrayLength(uint32_t length);
+	uint32_t getArrayLength() const;
+	/* number of previous snapshots drawn with fading colors */
+	void setArrayPersistence(uint32_t frames);
+	uint32_t getArrayPersistence() const;
+	/* number of snapshots in the running average, 1 disables averaging */
+	void setArrayAveraging(uint32_t frames);
+	uint32_t getArrayAveraging() const;
+	void addArrayFrame(const std::string& name, const std::vector<double>& frame);
+
+	/* number of samples reduced to a single min/max/mean bucket of the long history, 0 disables the decimation */
+	void setDecimationFactor(uint32_t factor);
+	uint32_t getDecimationFactor() const;
+	void setDecimatedMaxPoints(uint32_t maxPoints);
+	uint32_t getDecimatedMaxPoints() const;
+	void setDecimationMode(DecimationMode mode);
+	DecimationMode getDecimationMode() const;
+
 	displayFormat getSeriesDisplayFormat(const std::string& name) const;
 	void setSeriesDisplayFormat(const std::string& name, displayFormat format);
 	std::string getSeriesValueString(const std::string& name, double value);
@@ -158,6 +196,13 @@ class Plot
 	Domain domain = Domain::ANALOG;
 	TraceVarType traceVarType = TraceVarType::F32;
 	bool isHoveredOver = false;
+	uint32_t sampleFrequencyHz = 0;
+	uint32_t arrayLength = 16;
+	uint32_t arrayPersistence = 1;
+	uint32_t arrayAveraging = 1;
+	uint32_t decimationFactor = 0;
+	uint32_t decimatedMaxPoints = 10000;
+	DecimationMode decimationMode = DecimationMode::ENVELOPE;
 
 	Marker mx0;
 	Marker mx1;
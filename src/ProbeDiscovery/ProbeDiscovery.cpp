@@ -0,0 +1,129 @@
+#include "ProbeDiscovery.hpp"
+
+#include <algorithm>
+
+ProbeDiscovery::ProbeDiscovery(spdlog::logger* logger) : logger(logger)
+{
+}
+
+ProbeDiscovery::~ProbeDiscovery()
+{
+	stop();
+}
+
+void ProbeDiscovery::addSource(const std::string& source, Enumerator enumerator)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	sources.push_back({source, enumerator, {}});
+}
+
+void ProbeDiscovery::start(std::chrono::milliseconds period)
+{
+	if (isRunning)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		pollPeriod = period;
+		nextScan = Clock::now();
+	}
+
+	isRunning = true;
+	thread = std::thread(&ProbeDiscovery::discoveryThread, this);
+}
+
+void ProbeDiscovery::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		isRunning = false;
+	}
+	cv.notify_all();
+
+	if (thread.joinable())
+		thread.join();
+}
+
+void ProbeDiscovery::setPollPeriod(std::chrono::milliseconds period)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	pollPeriod = period;
+	nextScan = std::min(nextScan, Clock::now() + pollPeriod);
+}
+
+void ProbeDiscovery::requestRescan(std::chrono::milliseconds delay)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		nextScan = std::min(nextScan, Clock::now() + delay);
+	}
+	cv.notify_all();
+}
+
+std::vector<std::string> ProbeDiscovery::getDevices(const std::string& source) const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	auto it = std::find_if(sources.begin(), sources.end(), [&](const Source& s)
+						   { return s.name == source; });
+	return it == sources.end() ? std::vector<std::string>{} : it->devices;
+}
+
+bool ProbeDiscovery::popEvent(Event& event)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (events.empty())
+		return false;
+
+	event = std::move(events.front());
+	events.pop_front();
+	return true;
+}
+
+void ProbeDiscovery::discoveryThread()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	while (isRunning)
+	{
+		/* a rescan request moves nextScan forward and wakes the thread up, the wait is then recalculated */
+		if (Clock::now() < nextScan)
+		{
+			cv.wait_until(lock, nextScan);
+			continue;
+		}
+
+		nextScan = Clock::now() + pollPeriod;
+
+		/* the enumerators can take hundreds of milliseconds, the cache stays readable meanwhile */
+		lock.unlock();
+		scan();
+		lock.lock();
+	}
+}
+
+void ProbeDiscovery::scan()
+{
+	/* sources are only added before start, so they can be iterated without the lock */
+	for (size_t i = 0; i < sources.size(); i++)
+	{
+		auto devices = sources[i].enumerator();
+
+		std::lock_guard<std::mutex> lock(mtx);
+		if (!devices.has_value())
+		{
+			nextScan = std::min(nextScan, Clock::now() + retryPeriod);
+			continue;
+		}
+
+		if (*devices == sources[i].devices)
+			continue;
+
+		sources[i].devices = *devices;
+		logger->info("{} probes changed, {} connected", sources[i].name, devices->size());
+
+		if (events.size() >= maxEvents)
+			events.pop_front();
+		events.push_back({sources[i].name, std::move(*devices)});
+	}
+	scanCount++;
+}
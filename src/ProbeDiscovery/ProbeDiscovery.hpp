@@ -0,0 +1,82 @@
+#ifndef _PROBEDISCOVERY_HPP
+#define _PROBEDISCOVERY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+/* Background probe enumeration. Every source (probe type) has an enumerator that is only ever called from the
+   discovery thread, the GUI reads the cached lists and receives change events, so USB enumeration never runs
+   in the render loop. Rescans are triggered by hotplug notifications (see UsbHotplugMonitor), by explicit
+   requests and by periodic polling as a fallback. */
+class ProbeDiscovery
+{
+   public:
+	using Clock = std::chrono::steady_clock;
+	/* returns std::nullopt when the source can not be enumerated right now (e.g. an acquisition is running),
+	   the cached list is kept and the source is retried later */
+	using Enumerator = std::function<std::optional<std::vector<std::string>>()>;
+
+	struct Event
+	{
+		std::string source;
+		std::vector<std::string> devices;
+	};
+
+	ProbeDiscovery(spdlog::logger* logger);
+	~ProbeDiscovery();
+
+	/* sources have to be added before start */
+	void addSource(const std::string& source, Enumerator enumerator);
+	/* the first scan runs right away */
+	void start(std::chrono::milliseconds pollPeriod);
+	void stop();
+	void setPollPeriod(std::chrono::milliseconds period);
+
+	/* safe to call from any thread, including hotplug callbacks. The delay lets a freshly attached device settle */
+	void requestRescan(std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+	/* last known list, empty until the source was scanned */
+	std::vector<std::string> getDevices(const std::string& source) const;
+	/* returns false when there is no pending change */
+	bool popEvent(Event& event);
+	uint64_t getScanCount() const { return scanCount; }
+
+	static constexpr std::chrono::milliseconds retryPeriod{500};
+	static constexpr size_t maxEvents = 64;
+
+   private:
+	struct Source
+	{
+		std::string name;
+		Enumerator enumerator;
+		std::vector<std::string> devices;
+	};
+
+	void discoveryThread();
+	void scan();
+
+	std::vector<Source> sources;
+	std::deque<Event> events;
+	Clock::time_point nextScan{};
+	std::chrono::milliseconds pollPeriod{2000};
+
+	std::atomic<bool> isRunning = false;
+	std::atomic<uint64_t> scanCount = 0;
+	mutable std::mutex mtx;
+	std::condition_variable cv;
+	std::thread thread;
+
+	spdlog::logger* logger;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "UsbHotplugMonitor.hpp"
+
+UsbHotplugMonitor::UsbHotplugMonitor(ProbeDiscovery* probeDiscovery, spdlog::logger* logger) : probeDiscovery(probeDiscovery), logger(logger)
+{
+}
+
+UsbHotplugMonitor::~UsbHotplugMonitor()
+{
+	stop();
+}
+
+bool UsbHotplugMonitor::start()
+{
+	if (isRunning)
+		return true;
+
+	if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG))
+	{
+		logger->info("USB hotplug not supported, probes are discovered by polling");
+		return false;
+	}
+
+	if (libusb_init(&context) != LIBUSB_SUCCESS)
+	{
+		logger->error("USB hotplug monitor: libusb init failed");
+		context = nullptr;
+		return false;
+	}
+
+	for (size_t i = 0; i < vendorIds.size(); i++)
+	{
+		int result = libusb_hotplug_register_callback(context, static_cast<libusb_hotplug_event>(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT), static_cast<libusb_hotplug_flag>(0), vendorIds[i], LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY, &UsbHotplugMonitor::hotplugCallback, this, &handles[i]);
+
+		if (result != LIBUSB_SUCCESS)
+		{
+			logger->error("USB hotplug monitor: callback registration failed ({})", libusb_error_name(result));
+			for (size_t j = 0; j < i; j++)
+				libusb_hotplug_deregister_callback(context, handles[j]);
+			libusb_exit(context);
+			context = nullptr;
+			return false;
+		}
+	}
+
+	isRunning = true;
+	thread = std::thread(&UsbHotplugMonitor::eventThread, this);
+	logger->info("USB hotplug monitor started");
+	return true;
+}
+
+void UsbHotplugMonitor::stop()
+{
+	if (!isRunning)
+		return;
+
+	isRunning = false;
+	if (thread.joinable())
+		thread.join();
+
+	for (auto handle : handles)
+		libusb_hotplug_deregister_callback(context, handle);
+
+	libusb_exit(context);
+	context = nullptr;
+}
+
+int LIBUSB_CALL UsbHotplugMonitor::hotplugCallback(libusb_context* context, libusb_device* device, libusb_hotplug_event event, void* userData)
+{
+	auto* monitor = static_cast<UsbHotplugMonitor*>(userData);
+	monitor->probeDiscovery->requestRescan(event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED ? settleDelay : std::chrono::milliseconds(0));
+	/* keeps the callback registered */
+	return 0;
+}
+
+void UsbHotplugMonitor::eventThread()
+{
+	/* the timeout bounds the stop latency, the callbacks are invoked from within this call */
+	timeval timeout{0, 100000};
+
+	while (isRunning)
+		libusb_handle_events_timeout_completed(context, &timeout, nullptr);
+}
@@ -0,0 +1,45 @@
+#ifndef _USBHOTPLUGMONITOR_HPP
+#define _USBHOTPLUGMONITOR_HPP
+
+#include <libusb.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "ProbeDiscovery.hpp"
+#include "spdlog/spdlog.h"
+
+/* Requests a ProbeDiscovery rescan whenever an ST or SEGGER USB device is attached or removed. Uses a private
+   libusb context with its own event thread so it never interferes with the contexts of the probe libraries. */
+class UsbHotplugMonitor
+{
+   public:
+	UsbHotplugMonitor(ProbeDiscovery* probeDiscovery, spdlog::logger* logger);
+	~UsbHotplugMonitor();
+
+	/* returns false when libusb has no hotplug support on this platform, discovery has to rely on polling then */
+	bool start();
+	void stop();
+
+	static constexpr uint16_t stVendorId = 0x0483;
+	static constexpr uint16_t seggerVendorId = 0x1366;
+	/* the probes enumerate in stages and are not usable right after the arrival event */
+	static constexpr std::chrono::milliseconds settleDelay{300};
+
+   private:
+	static int LIBUSB_CALL hotplugCallback(libusb_context* context, libusb_device* device, libusb_hotplug_event event, void* userData);
+	void eventThread();
+
+	static constexpr std::array<uint16_t, 2> vendorIds{stVendorId, seggerVendorId};
+
+	ProbeDiscovery* probeDiscovery;
+	libusb_context* context = nullptr;
+	std::array<libusb_hotplug_callback_handle, vendorIds.size()> handles{};
+	std::atomic<bool> isRunning = false;
+	std::thread thread;
+
+	spdlog::logger* logger;
+};
+
+#endif
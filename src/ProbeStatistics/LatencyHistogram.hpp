@@ -0,0 +1,131 @@
+#ifndef _LATENCYHISTOGRAM_HPP
+#define _LATENCYHISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/* Lock-free log-linear histogram in the spirit of HdrHistogram. Every power of two range of values is split into
+   subBuckets linear buckets, so the relative error of a recorded value stays below 1/subBuckets over the whole
+   range while the histogram has a fixed size. Recording is a few relaxed atomic increments and can be done from
+   any thread, readers take a snapshot. */
+class LatencyHistogram
+{
+   public:
+	static constexpr uint32_t subBucketBits = 4;
+	static constexpr uint32_t subBuckets = 1u << subBucketBits;
+	/* values up to 2^40 ns (~18 minutes), larger ones land in the last bucket */
+	static constexpr uint32_t maxValueBits = 40;
+	static constexpr uint32_t bucketCount = (maxValueBits - subBucketBits + 1) * subBuckets;
+
+	struct Snapshot
+	{
+		std::array<uint64_t, bucketCount> buckets{};
+		uint64_t count = 0;
+		uint64_t sum = 0;
+		uint64_t min = 0;
+		uint64_t max = 0;
+
+		double getMean() const { return count == 0 ? 0.0 : static_cast<double>(sum) / count; }
+
+		/* highest value equivalent to the bucket holding the percentile, never above the recorded max */
+		uint64_t getPercentile(double percentile) const
+		{
+			if (count == 0)
+				return 0;
+
+			const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+			uint64_t cumulative = 0;
+
+			for (uint32_t i = 0; i < bucketCount; i++)
+			{
+				cumulative += buckets[i];
+				if (cumulative >= target)
+					return std::min(getBucketUpperBound(i), max);
+			}
+			return max;
+		}
+	};
+
+	void record(uint64_t value)
+	{
+		buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+		sum.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+
+		current = min.load(std::memory_order_relaxed);
+		while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/* the counters are read one by one, a snapshot taken during recording can be off by the values recorded meanwhile */
+	Snapshot getSnapshot() const
+	{
+		Snapshot snapshot{};
+		for (uint32_t i = 0; i < bucketCount; i++)
+			snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+
+		snapshot.count = count.load(std::memory_order_relaxed);
+		snapshot.sum = sum.load(std::memory_order_relaxed);
+		snapshot.max = max.load(std::memory_order_relaxed);
+		snapshot.min = snapshot.count == 0 ? 0 : min.load(std::memory_order_relaxed);
+		return snapshot;
+	}
+
+	void reset()
+	{
+		for (auto& bucket : buckets)
+			bucket.store(0, std::memory_order_relaxed);
+
+		count.store(0, std::memory_order_relaxed);
+		sum.store(0, std::memory_order_relaxed);
+		max.store(0, std::memory_order_relaxed);
+		min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+	}
+
+	static uint32_t getBucketIndex(uint64_t value)
+	{
+		/* the first range is linear with a resolution of 1 */
+		if (value < subBuckets)
+			return static_cast<uint32_t>(value);
+
+		const uint32_t shift = std::bit_width(value) - 1 - subBucketBits;
+		const uint32_t index = (shift + 1) * subBuckets + static_cast<uint32_t>(value >> shift) - subBuckets;
+		return std::min(index, bucketCount - 1);
+	}
+
+	static uint64_t getBucketLowerBound(uint32_t index)
+	{
+		if (index < subBuckets)
+			return index;
+
+		const uint32_t shift = index / subBuckets - 1;
+		return static_cast<uint64_t>(subBuckets + index % subBuckets) << shift;
+	}
+
+	static uint64_t getBucketUpperBound(uint32_t index)
+	{
+		if (index >= bucketCount - 1)
+			return std::numeric_limits<uint64_t>::max();
+		return getBucketLowerBound(index + 1) - 1;
+	}
+
+   private:
+	std::array<std::atomic<uint64_t>, bucketCount> buckets{};
+	std::atomic<uint64_t> count = 0;
+	std::atomic<uint64_t> sum = 0;
+	std::atomic<uint64_t> max = 0;
+	std::atomic<uint64_t> min = std::numeric_limits<uint64_t>::max();
+};
+
+#endif
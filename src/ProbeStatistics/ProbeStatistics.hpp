@@ -0,0 +1,107 @@
+#ifndef _PROBESTATISTICS_HPP
+#define _PROBESTATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "LatencyHistogram.hpp"
+
+/* Per-call instrumentation of the debug and trace probes - latency histograms in nanoseconds and failure and retry
+   counts of every probe operation. Recording is lock-free so it can be done from the sampling threads. */
+class ProbeStatistics
+{
+   public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Operation : uint8_t
+	{
+		READ_MEMORY = 0,
+		WRITE_MEMORY = 1,
+		READ_BATCH = 2,
+		READ_ENTRIES = 3,
+		READ_TRACE = 4,
+		COUNT = 5,
+	};
+
+	static constexpr const char* operationNames[] = {"readMemory", "writeMemory", "readMemoryBatch", "readEntries", "readTraceBuffer"};
+	static constexpr size_t operationCount = static_cast<size_t>(Operation::COUNT);
+
+	struct Summary
+	{
+		LatencyHistogram::Snapshot latency;
+		uint64_t failures = 0;
+		uint64_t retries = 0;
+	};
+
+	void record(Operation operation, Clock::time_point start, bool success)
+	{
+		auto& counters = operations[static_cast<size_t>(operation)];
+		counters.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+		if (!success)
+			counters.failures.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void addRetry(Operation operation)
+	{
+		operations[static_cast<size_t>(operation)].retries.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Summary getSummary(Operation operation) const
+	{
+		auto& counters = operations[static_cast<size_t>(operation)];
+		return {counters.latency.getSnapshot(), counters.failures.load(std::memory_order_relaxed), counters.retries.load(std::memory_order_relaxed)};
+	}
+
+	void reset()
+	{
+		for (auto& counters : operations)
+		{
+			counters.latency.reset();
+			counters.failures = 0;
+			counters.retries = 0;
+		}
+	}
+
+	/* summary table followed by the non-empty buckets of every operation, times in microseconds */
+	std::string dump() const
+	{
+		std::ostringstream out;
+		out << "operation,calls,failures,retries,mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n";
+
+		for (size_t i = 0; i < operationCount; i++)
+		{
+			auto summary = getSummary(static_cast<Operation>(i));
+			auto& latency = summary.latency;
+			out << operationNames[i] << ',' << latency.count << ',' << summary.failures << ',' << summary.retries << ',' << latency.getMean() / 1000.0 << ',' << latency.getPercentile(50.0) / 1000.0 << ',' << latency.getPercentile(90.0) / 1000.0 << ',' << latency.getPercentile(99.0) / 1000.0 << ',' << latency.getPercentile(99.9) / 1000.0 << ',' << latency.max / 1000.0 << '\n';
+		}
+
+		out << "\noperation,bucket_from_us,bucket_to_us,count\n";
+		for (size_t i = 0; i < operationCount; i++)
+		{
+			auto latency = getSummary(static_cast<Operation>(i)).latency;
+			for (uint32_t j = 0; j < LatencyHistogram::bucketCount; j++)
+			{
+				if (latency.buckets[j] == 0)
+					continue;
+				out << operationNames[i] << ',' << LatencyHistogram::getBucketLowerBound(j) / 1000.0 << ',' << LatencyHistogram::getBucketUpperBound(j) / 1000.0 << ',' << latency.buckets[j] << '\n';
+			}
+		}
+		return out.str();
+	}
+
+   private:
+	struct Counters
+	{
+		LatencyHistogram latency;
+		std::atomic<uint64_t> failures = 0;
+		std::atomic<uint64_t> retries = 0;
+	};
+
+	std::array<Counters, operationCount> operations{};
+};
+
+#endif
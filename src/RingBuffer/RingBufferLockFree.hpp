@@ -0,0 +1,92 @@
+#ifndef __RINGBUFFERLOCKFREE_HPP
+#define __RINGBUFFERLOCKFREE_HPP
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+/* single producer single consumer queue - push must be called from one thread and pop from another one */
+template <typename T, size_t capacity>
+class RingBufferLockFree
+{
+   public:
+	explicit RingBufferLockFree() : read_idx(0), write_idx(0) {}
+
+	bool push(const T& item)
+	{
+		size_t write = write_idx.load(std::memory_order_relaxed);
+		size_t next = (write + 1) % (capacity + 1);
+
+		if (next == read_idx.load(std::memory_order_acquire))
+			return false;
+
+		buffer[write] = item;
+		write_idx.store(next, std::memory_order_release);
+		return true;
+	}
+
+	std::optional<T> pop()
+	{
+		size_t read = read_idx.load(std::memory_order_relaxed);
+
+		if (read == write_idx.load(std::memory_order_acquire))
+			return std::nullopt;
+
+		T item = std::move(buffer[read]);
+		read_idx.store((read + 1) % (capacity + 1), std::memory_order_release);
+		return item;
+	}
+
+	/* in place variants for elements that own memory - slots are reused so their capacity survives between pushes.
+	   getWriteSlot returns nullptr if the buffer is full, the element is published by commitWrite */
+	T* getWriteSlot()
+	{
+		size_t write = write_idx.load(std::memory_order_relaxed);
+
+		if ((write + 1) % (capacity + 1) == read_idx.load(std::memory_order_acquire))
+			return nullptr;
+
+		return &buffer[write];
+	}
+
+	void commitWrite()
+	{
+		write_idx.store((write_idx.load(std::memory_order_relaxed) + 1) % (capacity + 1), std::memory_order_release);
+	}
+
+	/* returns nullptr if the buffer is empty, the element stays valid until popFront */
+	T* front()
+	{
+		size_t read = read_idx.load(std::memory_order_relaxed);
+
+		if (read == write_idx.load(std::memory_order_acquire))
+			return nullptr;
+
+		return &buffer[read];
+	}
+
+	void popFront()
+	{
+		read_idx.store((read_idx.load(std::memory_order_relaxed) + 1) % (capacity + 1), std::memory_order_release);
+	}
+
+	size_t size() const
+	{
+		size_t write = write_idx.load(std::memory_order_acquire);
+		size_t read = read_idx.load(std::memory_order_acquire);
+		return (write + capacity + 1 - read) % (capacity + 1);
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+   private:
+	/* one slot is always left empty to distinguish a full buffer from an empty one */
+	std::array<T, capacity + 1> buffer;
+	std::atomic<size_t> read_idx;
+	std::atomic<size_t> write_idx;
+};
+
+#endif
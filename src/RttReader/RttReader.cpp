@@ -0,0 +1,196 @@
+#include "RttReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+RttReader::RttReader(IDebugProbe* probe, spdlog::logger* logger) : probe(probe), logger(logger)
+{
+}
+
+bool RttReader::attach(uint32_t address)
+{
+	controlBlockAddress = 0;
+	upBuffers.clear();
+
+	uint8_t header[controlBlockHeaderSize]{};
+	if (!readBlock(address, header, controlBlockHeaderSize))
+		return fail("RTT control block read error!");
+
+	if (std::memcmp(header, controlBlockId, sizeof(controlBlockId)) != 0)
+		return fail(fmt::format("No RTT control block at 0x{:08x}!", address));
+
+	uint32_t upCount = 0;
+	uint32_t downCount = 0;
+	std::memcpy(&upCount, header + controlBlockIdSize, sizeof(uint32_t));
+	std::memcpy(&downCount, header + controlBlockIdSize + sizeof(uint32_t), sizeof(uint32_t));
+
+	if (upCount == 0 || upCount > maxBuffers || downCount > maxBuffers)
+		return fail(fmt::format("RTT control block at 0x{:08x} has invalid buffer counts ({} up, {} down)!", address, upCount, downCount));
+
+	std::vector<uint8_t> descriptors(upCount * bufferDescriptorSize);
+	if (!readBlock(address + controlBlockHeaderSize, descriptors.data(), descriptors.size()))
+		return fail("RTT buffer descriptors read error!");
+
+	for (uint32_t i = 0; i < upCount; i++)
+	{
+		uint32_t fields[bufferDescriptorSize / sizeof(uint32_t)]{};
+		std::memcpy(fields, descriptors.data() + i * bufferDescriptorSize, bufferDescriptorSize);
+
+		UpBuffer buffer{};
+		buffer.descriptorAddress = address + controlBlockHeaderSize + i * bufferDescriptorSize;
+		buffer.bufferAddress = fields[1];
+		buffer.size = fields[2];
+
+		/* the name is informative only, a failed read leaves it empty */
+		char name[maxNameLength + 1]{};
+		if (fields[0] != 0 && readBlock(fields[0], (uint8_t*)name, maxNameLength))
+			buffer.name = std::string(name, strnlen(name, maxNameLength));
+
+		upBuffers.push_back(buffer);
+	}
+
+	controlBlockAddress = address;
+	logger->info("RTT control block found at 0x{:08x} with {} up-buffers", address, upCount);
+	return true;
+}
+
+bool RttReader::find(uint32_t ramStart, uint32_t ramSize)
+{
+	/* the chunks overlap so that an ID crossing a chunk boundary is not missed */
+	const uint32_t step = scanChunkSize - controlBlockIdSize;
+	std::vector<uint8_t> chunk(scanChunkSize);
+
+	for (uint32_t offset = 0; offset < ramSize; offset += step)
+	{
+		const uint32_t length = std::min(scanChunkSize, ramSize - offset);
+		if (length < sizeof(controlBlockId))
+			break;
+
+		if (!readBlock(ramStart + offset, chunk.data(), length))
+			return fail(fmt::format("RAM read error at 0x{:08x} while searching for the RTT control block!", ramStart + offset));
+
+		auto begin = chunk.begin();
+		auto end = chunk.begin() + length;
+		while ((begin = std::search(begin, end, controlBlockId, controlBlockId + sizeof(controlBlockId))) != end)
+		{
+			const uint32_t candidate = ramStart + offset + (begin - chunk.begin());
+			/* the control block is a struct of words, an unaligned match is a copy of the string */
+			if (candidate % sizeof(uint32_t) == 0 && attach(candidate))
+				return true;
+			begin++;
+		}
+	}
+
+	return fail(fmt::format("No RTT control block in 0x{:08x} - 0x{:08x}!", ramStart, ramStart + ramSize));
+}
+
+int32_t RttReader::read(uint32_t bufferIndex, std::vector<uint8_t>& data)
+{
+	if (bufferIndex >= upBuffers.size())
+	{
+		fail("RTT up-buffer index out of range!");
+		return -1;
+	}
+
+	auto& buffer = upBuffers[bufferIndex];
+	if (buffer.size == 0)
+		return 0;
+
+	uint32_t offsets[2]{};
+	if (!readBlock(buffer.descriptorAddress + writeOffsetOffset, (uint8_t*)offsets, sizeof(offsets)))
+	{
+		fail("RTT offsets read error!");
+		return -1;
+	}
+
+	const uint32_t writeOffset = offsets[0];
+	const uint32_t readOffset = offsets[1];
+
+	if (writeOffset >= buffer.size || readOffset >= buffer.size)
+	{
+		fail(fmt::format("RTT up-buffer {} offsets out of range (write {}, read {}, size {})!", bufferIndex, writeOffset, readOffset, buffer.size));
+		return -1;
+	}
+
+	if (writeOffset == readOffset)
+		return 0;
+
+	/* a wrapped ring buffer takes a second read from its beginning */
+	const uint32_t first = writeOffset > readOffset ? writeOffset - readOffset : buffer.size - readOffset;
+	const uint32_t second = writeOffset > readOffset ? 0 : writeOffset;
+
+	const size_t previousSize = data.size();
+	data.resize(previousSize + first + second);
+
+	if (!readBlock(buffer.bufferAddress + readOffset, data.data() + previousSize, first) || (second > 0 && !readBlock(buffer.bufferAddress, data.data() + previousSize + first, second)))
+	{
+		data.resize(previousSize);
+		fail("RTT up-buffer read error!");
+		return -1;
+	}
+
+	/* the bytes are freed on the target only after they were read */
+	uint32_t newReadOffset = writeOffset;
+	if (!probe->writeMemory(buffer.descriptorAddress + readOffsetOffset, (uint8_t*)&newReadOffset, sizeof(uint32_t)))
+	{
+		data.resize(previousSize);
+		fail("RTT read offset write error!");
+		return -1;
+	}
+
+	bytesRead += first + second;
+	return static_cast<int32_t>(first + second);
+}
+
+bool RttReader::readBlock(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	staging.resize(std::max<size_t>(size, sizeof(uint32_t)));
+	if (!probe->readMemory(address, staging.data(), size))
+		return false;
+
+	std::memcpy(buf, staging.data(), size);
+	return true;
+}
+
+bool RttReader::fail(const std::string& message)
+{
+	lastErrorMsg = message;
+	logger->error(lastErrorMsg);
+	return false;
+}
+
+size_t RttRecordDecoder::decode(std::span<const uint8_t> data, std::vector<Record>& records)
+{
+	pending.insert(pending.end(), data.begin(), data.end());
+
+	const size_t count = pending.size() / recordSize;
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint8_t* raw = pending.data() + i * recordSize;
+		Record record{};
+		uint32_t timestamp = 0;
+
+		record.channel = raw[0];
+		std::memcpy(&timestamp, raw + 1, sizeof(uint32_t));
+		std::memcpy(&record.value, raw + 1 + sizeof(uint32_t), sizeof(uint32_t));
+
+		if (!first && timestamp < lastTimestamp)
+			timestampHigh += 1ull << 32;
+		first = false;
+		lastTimestamp = timestamp;
+
+		record.timestamp = timestampHigh | timestamp;
+		records.push_back(record);
+	}
+
+	pending.erase(pending.begin(), pending.begin() + count * recordSize);
+	return count;
+}
+
+void RttRecordDecoder::reset()
+{
+	pending.clear();
+	lastTimestamp = 0;
+	timestampHigh = 0;
+	first = true;
+}
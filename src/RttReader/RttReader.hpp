@@ -0,0 +1,115 @@
+#ifndef _RTTREADER_HPP
+#define _RTTREADER_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/* Host side of SEGGER RTT built on the plain memory access of a debug probe - no SWO pin is needed and the
+   throughput is limited by the probe block read speed only. The control block is located either at the address
+   of the _SEGGER_RTT symbol from the ELF file or by scanning the RAM for its ID string. Up-buffers are drained
+   with at most two block reads (the ring buffer may wrap) and a single word write of the read offset.
+   The probe has to be running in NORMAL mode. */
+class RttReader
+{
+   public:
+	typedef struct Settings
+	{
+		bool enabled = false;
+		uint32_t upBuffer = 0;
+		uint32_t readFrequencyHz = 100;
+		/* searched for the control block when the ELF file has no _SEGGER_RTT symbol */
+		uint32_t ramStart = 0x20000000;
+		uint32_t ramSize = 0x10000;
+		/* comma separated variable names, records of channel i update the i-th variable */
+		std::string channelVariables = "";
+	} Settings;
+
+	struct UpBuffer
+	{
+		std::string name;
+		uint32_t descriptorAddress = 0;
+		uint32_t bufferAddress = 0;
+		uint32_t size = 0;
+	};
+
+	RttReader(IDebugProbe* probe, spdlog::logger* logger);
+
+	/* validates and reads the control block at the _SEGGER_RTT symbol address */
+	bool attach(uint32_t controlBlockAddress);
+	/* searches the RAM range for the control block ID, then attaches to it */
+	bool find(uint32_t ramStart, uint32_t ramSize);
+	bool isAttached() const { return controlBlockAddress != 0; }
+	uint32_t getControlBlockAddress() const { return controlBlockAddress; }
+
+	const std::vector<UpBuffer>& getUpBuffers() const { return upBuffers; }
+
+	/* appends all bytes available in the up-buffer to data and frees them on the target.
+	   Returns the number of bytes read or -1 on a probe error or corrupted offsets */
+	int32_t read(uint32_t bufferIndex, std::vector<uint8_t>& data);
+
+	uint64_t getBytesRead() const { return bytesRead; }
+	std::string getLastErrorMsg() const { return lastErrorMsg; }
+
+	static constexpr const char controlBlockId[] = "SEGGER RTT";
+	static constexpr uint32_t controlBlockIdSize = 16;
+	static constexpr uint32_t controlBlockHeaderSize = controlBlockIdSize + 2 * sizeof(uint32_t);
+	/* sName, pBuffer, SizeOfBuffer, WrOff, RdOff, Flags */
+	static constexpr uint32_t bufferDescriptorSize = 6 * sizeof(uint32_t);
+	static constexpr uint32_t writeOffsetOffset = 3 * sizeof(uint32_t);
+	static constexpr uint32_t readOffsetOffset = 4 * sizeof(uint32_t);
+
+   private:
+	bool readBlock(uint32_t address, uint8_t* buf, uint32_t size);
+	bool fail(const std::string& message);
+
+	static constexpr uint32_t maxBuffers = 16;
+	static constexpr uint32_t maxNameLength = 32;
+	static constexpr uint32_t scanChunkSize = 4096;
+
+	IDebugProbe* probe;
+	uint32_t controlBlockAddress = 0;
+	std::vector<UpBuffer> upBuffers;
+	/* single word reads of the probes fill a whole word, the staging buffer is never smaller than that */
+	std::vector<uint8_t> staging;
+	uint64_t bytesRead = 0;
+	std::string lastErrorMsg;
+
+	spdlog::logger* logger;
+};
+
+/* Splits the byte stream of an up-buffer into fixed size little endian records:
+	  uint8_t channel    - trace channel or variable index
+	  uint32_t timestamp - target ticks, e.g. DWT->CYCCNT
+	  uint32_t value
+   The target has to write whole records with a single SEGGER_RTT_Write so that a full buffer never splits one.
+   Records can straddle two reads, the partial tail is kept until the next call. */
+class RttRecordDecoder
+{
+   public:
+	struct Record
+	{
+		uint8_t channel = 0;
+		/* extended to 64 bits across the 32-bit timestamp wraps */
+		uint64_t timestamp = 0;
+		uint32_t value = 0;
+	};
+
+	static constexpr uint32_t recordSize = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
+	/* appends the complete records to records, returns their count */
+	size_t decode(std::span<const uint8_t> data, std::vector<Record>& records);
+	void reset();
+
+   private:
+	std::vector<uint8_t> pending;
+	uint32_t lastTimestamp = 0;
+	uint64_t timestampHigh = 0;
+	bool first = true;
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "SamplingPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+void SamplingPlanner::setProbe(uint32_t newProbeType, uint32_t newSpeedkHz)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	if (newProbeType != probeType)
+	{
+		calibrationSamples = 0;
+		calibratedOverheadS = 0.0;
+	}
+
+	probeType = newProbeType;
+	speedkHz = std::max(newSpeedkHz, 1u);
+}
+
+void SamplingPlanner::addMeasurement(uint32_t size, double latencyS)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	/* only the part of the latency that is not explained by the SWD transfer itself */
+	double overhead = std::max(0.0, latencyS - getSwdTime(0, size));
+	calibrationSamples++;
+	calibratedOverheadS += (overhead - calibratedOverheadS) / std::min(calibrationSamples, static_cast<size_t>(1000));
+}
+
+void SamplingPlanner::addMeasurement(std::span<const std::pair<uint32_t, uint8_t>> reads, double latencyS)
+{
+	if (reads.empty())
+		return;
+
+	double swdTime = 0.0;
+	for (auto& [address, size] : reads)
+		swdTime += getSwdTime(0, size);
+
+	/* the overhead is spread evenly, pipelining probes show up as a lower per-read overhead */
+	const double overhead = std::max(0.0, (latencyS - swdTime) / reads.size());
+
+	std::lock_guard<std::mutex> lock(mtx);
+	for (size_t i = 0; i < reads.size(); i++)
+	{
+		calibrationSamples++;
+		calibratedOverheadS += (overhead - calibratedOverheadS) / std::min(calibrationSamples, static_cast<size_t>(1000));
+	}
+}
+
+void SamplingPlanner::resetCalibration()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	calibrationSamples = 0;
+	calibratedOverheadS = 0.0;
+}
+
+bool SamplingPlanner::isCalibrated() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return calibrationSamples >= minCalibrationSamples;
+}
+
+double SamplingPlanner::getTransactionOverhead() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return getOverheadUnlocked();
+}
+
+double SamplingPlanner::getOverheadUnlocked() const
+{
+	if (calibrationSamples >= minCalibrationSamples)
+		return calibratedOverheadS;
+	return getDefaultOverhead();
+}
+
+double SamplingPlanner::getDefaultOverhead() const
+{
+	return probeType == jlinkProbe ? jlinkTransactionOverheadS : stlinkTransactionOverheadS;
+}
+
+double SamplingPlanner::getSwdTime(uint32_t address, uint32_t size) const
+{
+	if (size == 0)
+		return 0.0;
+
+	/* AP accesses are word aligned */
+	uint32_t start = address & ~3u;
+	uint32_t end = (address + size + 3) & ~3u;
+	uint32_t words = (end - start) / 4;
+
+	/* one additional transfer for the TAR write */
+	return static_cast<double>((words + 1) * swdBitsPerTransfer) / (speedkHz * 1000.0);
+}
+
+std::vector<SamplingPlanner::Block> SamplingPlanner::coalesce(const std::vector<Entry>& entries) const
+{
+	std::vector<Entry> sorted = entries;
+	std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b)
+			  { return a.address < b.address; });
+
+	double overhead = getTransactionOverhead();
+	std::vector<Block> blocks;
+
+	for (auto& entry : sorted)
+	{
+		if (!blocks.empty())
+		{
+			auto& last = blocks.back();
+			uint32_t end = std::max(last.address + last.size, entry.address + entry.size);
+			uint32_t mergedSize = end - last.address;
+
+			double separateCost = getSwdTime(last.address, last.size) + overhead + getSwdTime(entry.address, entry.size);
+			double mergedCost = getSwdTime(last.address, mergedSize);
+
+			if (mergedSize <= maxBlockSize && mergedCost < separateCost)
+			{
+				last.size = mergedSize;
+				last.entries++;
+				continue;
+			}
+		}
+		blocks.push_back({entry.address, entry.size, 1});
+	}
+
+	return blocks;
+}
+
+SamplingPlanner::Estimate SamplingPlanner::estimate(const std::vector<Entry>& entries, uint32_t requestedFrequencyHz) const
+{
+	Estimate result{};
+
+	if (entries.empty())
+		return result;
+
+	double overhead = getTransactionOverhead();
+
+	/* NORMAL mode - every entry is a separate transaction, entries of slower rate classes are read only on some ticks */
+	double tickTime = 0.0;
+	double baseTickTime = 0.0;
+	double hssTime = 0.0;
+	for (auto& entry : entries)
+	{
+		double entryTime = overhead + getSwdTime(entry.address, entry.size);
+		tickTime += entryTime / std::max(entry.divider, 1u);
+		baseTickTime += entryTime;
+		hssTime += hssEntryOverheadS + getSwdTime(entry.address, entry.size);
+	}
+	result.normalMaxFrequencyHz = 1.0 / tickTime;
+
+	result.blocks = coalesce(entries);
+	double coalescedTickTime = 0.0;
+	for (auto& block : result.blocks)
+		coalescedTickTime += overhead + getSwdTime(block.address, block.size);
+	result.coalescedMaxFrequencyHz = 1.0 / coalescedTickTime;
+
+	if (probeType == jlinkProbe)
+		result.hssMaxFrequencyHz = std::min(1.0 / hssTime, hssMaxFrequencyHz);
+	/* the simulated target produces the HSS ticks on demand */
+	else if (probeType == simulatedProbe)
+		result.hssMaxFrequencyHz = hssMaxFrequencyHz;
+	/* the STLink sampling thread reads every entry on every tick */
+	else if (probeType == stlinkProbe)
+		result.hssMaxFrequencyHz = 1.0 / baseTickTime;
+
+	if (requestedFrequencyHz > result.normalMaxFrequencyHz)
+	{
+		if (result.blocks.size() < entries.size())
+			result.suggestions.push_back("Reading " + std::to_string(entries.size()) + " variables as " + std::to_string(result.blocks.size()) + " memory blocks would allow ~" + std::to_string(static_cast<uint32_t>(result.coalescedMaxFrequencyHz)) + " Hz.");
+
+		if (tickTime >= baseTickTime)
+			result.suggestions.push_back("Lower the sampling frequency of slow plots to spread their reads over multiple ticks.");
+
+		if (result.hssMaxFrequencyHz > requestedFrequencyHz)
+			result.suggestions.push_back("HSS mode can reach the requested frequency.");
+		else
+			result.suggestions.push_back("Increase the SWD speed or reduce the number of sampled variables.");
+	}
+
+	return result;
+}
@@ -0,0 +1,88 @@
+#ifndef _SAMPLINGPLANNER_HPP
+#define _SAMPLINGPLANNER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Predicts the achievable sampling frequency of a sample list based on a simple probe latency and SWD transfer model.
+The per-transaction probe overhead can be calibrated with latencies measured during the acquisition. */
+class SamplingPlanner
+{
+   public:
+	struct Entry
+	{
+		uint32_t address;
+		uint8_t size;
+		/* entry is read every divider-th tick */
+		uint32_t divider = 1;
+	};
+
+	/* contiguous memory region that can be read in a single transaction */
+	struct Block
+	{
+		uint32_t address;
+		uint32_t size;
+		size_t entries;
+	};
+
+	struct Estimate
+	{
+		double normalMaxFrequencyHz = 0.0;
+		double coalescedMaxFrequencyHz = 0.0;
+		/* 0 if HSS is not supported by the probe */
+		double hssMaxFrequencyHz = 0.0;
+		std::vector<Block> blocks;
+		std::vector<std::string> suggestions;
+	};
+
+	static constexpr uint32_t maxBlockSize = 1024;
+	static constexpr size_t minCalibrationSamples = 16;
+
+	SamplingPlanner() = default;
+
+	/* probeType as in IDebugProbe::DebugProbeSettings::debugProbe, calibration is reset on probe change */
+	void setProbe(uint32_t probeType, uint32_t speedkHz);
+
+	Estimate estimate(const std::vector<Entry>& entries, uint32_t requestedFrequencyHz) const;
+
+	void addMeasurement(uint32_t size, double latencyS);
+	/* one measurement of a batch of reads done back to back, each read counts as a calibration sample */
+	void addMeasurement(std::span<const std::pair<uint32_t, uint8_t>> reads, double latencyS);
+	void resetCalibration();
+	bool isCalibrated() const;
+	double getTransactionOverhead() const;
+
+	/* time needed to transfer size bytes starting at address over SWD, including the TAR setup */
+	double getSwdTime(uint32_t address, uint32_t size) const;
+
+	/* coalesces entries into blocks whenever reading the gap is cheaper than a separate transaction */
+	std::vector<Block> coalesce(const std::vector<Entry>& entries) const;
+
+   private:
+	static constexpr uint32_t swdBitsPerTransfer = 46;
+	static constexpr uint32_t stlinkProbe = 0;
+	static constexpr uint32_t jlinkProbe = 1;
+	static constexpr uint32_t simulatedProbe = 2;
+	static constexpr double stlinkTransactionOverheadS = 250e-6;
+	static constexpr double jlinkTransactionOverheadS = 125e-6;
+	/* per-variable cost of HSS on the J-Link side */
+	static constexpr double hssEntryOverheadS = 2e-6;
+	static constexpr double hssMaxFrequencyHz = 1000000.0;
+
+	double getDefaultOverhead() const;
+	double getOverheadUnlocked() const;
+
+	uint32_t probeType = stlinkProbe;
+	uint32_t speedkHz = 4000;
+
+	size_t calibrationSamples = 0;
+	double calibratedOverheadS = 0.0;
+
+	mutable std::mutex mtx;
+};
+
+#endif
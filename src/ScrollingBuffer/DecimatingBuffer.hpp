@@ -0,0 +1,129 @@
+#ifndef __DECIMATINGBUFFER_HPP
+#define __DECIMATINGBUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+/* Long history companion of ScrollingBuffer. Every factor points are reduced to a single bucket holding
+   their min, max and mean, so that short spikes stay visible no matter how long the history is. */
+template <typename T>
+class DecimatingBuffer
+{
+   public:
+	struct Bucket
+	{
+		/* timestamp of the first point in the bucket */
+		T time;
+		T min;
+		T max;
+		T mean;
+	};
+
+	DecimatingBuffer() { data.resize(maxSize); }
+	~DecimatingBuffer() = default;
+
+	void addPoint(T time, T value)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+
+		if (count == 0)
+			current = {time, value, value, T{}};
+
+		current.min = std::min(current.min, value);
+		current.max = std::max(current.max, value);
+		sum += value;
+
+		if (++count < factor)
+			return;
+
+		current.mean = sum / static_cast<T>(count);
+		data[offset] = current;
+		offset = (offset + 1) % maxSize;
+		if (offset == 0)
+			isFull = true;
+
+		count = 0;
+		sum = T{};
+	}
+
+	void copyData()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		dataCopy = data;
+		offsetCopy = offset;
+		sizeCopy = isFull ? maxSize : offset;
+	}
+
+	/* valid after copyData, buckets are stored in a ring starting at getOffsetCopy() */
+	const Bucket* getFirstElementCopy() const { return dataCopy.data(); }
+	uint32_t getOffsetCopy() const { return offsetCopy; }
+	uint32_t getSizeCopy() const { return sizeCopy; }
+
+	uint32_t getSize() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return isFull ? maxSize : offset;
+	}
+
+	std::vector<Bucket> getLinearData() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		std::vector<Bucket> vec;
+
+		if (isFull)
+			vec.insert(vec.end(), data.begin() + offset, data.end());
+		vec.insert(vec.end(), data.begin(), data.begin() + offset);
+		return vec;
+	}
+
+	void erase()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		offset = 0;
+		isFull = false;
+		count = 0;
+		sum = T{};
+	}
+
+	void setFactor(uint32_t newFactor)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		factor = std::max(1u, newFactor);
+		offset = 0;
+		isFull = false;
+		count = 0;
+		sum = T{};
+	}
+	uint32_t getFactor() const { return factor; }
+
+	void setMaxSize(uint32_t newMaxSize)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		maxSize = std::max(1u, newMaxSize);
+		data.assign(maxSize, Bucket{});
+		offset = 0;
+		isFull = false;
+	}
+	uint32_t getMaxSize() const { return maxSize; }
+
+   private:
+	mutable std::mutex mtx;
+	uint32_t factor = 100;
+	uint32_t maxSize = 10000;
+	uint32_t offset = 0;
+	bool isFull = false;
+
+	Bucket current{};
+	uint32_t count = 0;
+	T sum{};
+
+	std::vector<Bucket> data;
+	std::vector<Bucket> dataCopy;
+	uint32_t offsetCopy = 0;
+	uint32_t sizeCopy = 0;
+};
+
+#endif
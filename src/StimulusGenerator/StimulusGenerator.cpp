@@ -0,0 +1,114 @@
+#include "StimulusGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numbers>
+#include <sstream>
+
+StimulusGenerator::StimulusGenerator(const Settings& settings) : settings(settings)
+{
+}
+
+void StimulusGenerator::setSettings(const Settings& newSettings)
+{
+	settings = newSettings;
+}
+
+StimulusGenerator::Settings StimulusGenerator::getSettings() const
+{
+	return settings;
+}
+
+bool StimulusGenerator::isEnabled() const
+{
+	return settings.type != Type::DISABLED;
+}
+
+bool StimulusGenerator::loadProfile(const std::string& path)
+{
+	std::ifstream file(path);
+
+	if (!file.is_open())
+		return false;
+
+	std::vector<std::pair<double, double>> points;
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+		std::replace(line.begin(), line.end(), ';', ',');
+		std::istringstream stream(line);
+		double t = 0.0;
+		double value = 0.0;
+		char delimiter = 0;
+
+		/* header and malformed lines are skipped */
+		if (!(stream >> t >> delimiter >> value) || delimiter != ',')
+			continue;
+
+		points.push_back({t, value});
+	}
+
+	if (points.empty())
+		return false;
+
+	setProfile(points);
+	return true;
+}
+
+void StimulusGenerator::setProfile(const std::vector<std::pair<double, double>>& points)
+{
+	profile = points;
+	std::sort(profile.begin(), profile.end());
+}
+
+double StimulusGenerator::getValue(double t) const
+{
+	switch (settings.type)
+	{
+		case Type::STEP:
+			return t < settings.time ? settings.offset : settings.offset + settings.amplitude;
+		case Type::RAMP:
+			if (settings.time <= 0.0)
+				return settings.offset;
+			return settings.offset + settings.amplitude * (std::fmod(t, settings.time) / settings.time);
+		case Type::SINE:
+			return settings.offset + settings.amplitude * std::sin(2.0 * std::numbers::pi * settings.frequencyHz * t);
+		case Type::CHIRP:
+		{
+			if (settings.time <= 0.0)
+				return settings.offset;
+			/* linear chirp repeated every period */
+			double tc = std::fmod(t, settings.time);
+			double phase = 2.0 * std::numbers::pi * (settings.frequencyHz * tc + (settings.endFrequencyHz - settings.frequencyHz) * tc * tc / (2.0 * settings.time));
+			return settings.offset + settings.amplitude * std::sin(phase);
+		}
+		case Type::PROFILE:
+			return getProfileValue(t);
+		default:
+			return settings.offset;
+	}
+}
+
+double StimulusGenerator::getProfileValue(double t) const
+{
+	if (profile.empty())
+		return settings.offset;
+
+	if (t <= profile.front().first)
+		return profile.front().second;
+
+	if (t >= profile.back().first)
+		return profile.back().second;
+
+	auto next = std::upper_bound(profile.begin(), profile.end(), t, [](double value, const std::pair<double, double>& point)
+								 { return value < point.first; });
+	auto prev = std::prev(next);
+
+	double dt = next->first - prev->first;
+	if (dt <= 0.0)
+		return next->second;
+
+	return prev->second + (next->second - prev->second) * (t - prev->first) / dt;
+}
@@ -0,0 +1,60 @@
+#ifndef _STIMULUSGENERATOR_HPP
+#define _STIMULUSGENERATOR_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Host-side waveform used to drive a target variable during acquisition */
+class StimulusGenerator
+{
+   public:
+	enum class Type : uint8_t
+	{
+		DISABLED = 0,
+		STEP = 1,
+		RAMP = 2,
+		SINE = 3,
+		CHIRP = 4,
+		PROFILE = 5,
+	};
+
+	typedef struct Settings
+	{
+		Type type = Type::DISABLED;
+		std::string variableName = "";
+		uint32_t writeFrequencyHz = 1000;
+		double offset = 0.0;
+		double amplitude = 1.0;
+		/* STEP: time of the step, RAMP and CHIRP: period of the waveform */
+		double time = 1.0;
+		/* SINE: frequency, CHIRP: start frequency */
+		double frequencyHz = 1.0;
+		/* CHIRP: frequency reached at the end of the period */
+		double endFrequencyHz = 10.0;
+		std::string profilePath = "";
+	} Settings;
+
+	StimulusGenerator() = default;
+	explicit StimulusGenerator(const Settings& settings);
+
+	void setSettings(const Settings& newSettings);
+	Settings getSettings() const;
+	bool isEnabled() const;
+
+	/* CSV profile with "time,value" lines, time in seconds in ascending order */
+	bool loadProfile(const std::string& path);
+	void setProfile(const std::vector<std::pair<double, double>>& points);
+
+	/* value of the waveform t seconds after the acquisition start */
+	double getValue(double t) const;
+
+   private:
+	double getProfileValue(double t) const;
+
+	Settings settings{};
+	std::vector<std::pair<double, double>> profile;
+};
+
+#endif
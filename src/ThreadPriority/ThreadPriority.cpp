@@ -0,0 +1,88 @@
+#include "ThreadPriority.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+bool ThreadPriority::isSupported()
+{
+#if defined(__linux__)
+	return true;
+#else
+	return false;
+#endif
+}
+
+int32_t ThreadPriority::getCoreCount()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+#if defined(__linux__)
+bool ThreadPriority::apply(const Settings& settings, std::string& errorMsg)
+{
+	bool result = true;
+	errorMsg.clear();
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+
+	if (settings.cpuCore >= getCoreCount())
+	{
+		errorMsg += "CPU core " + std::to_string(settings.cpuCore) + " does not exist. ";
+		result = false;
+	}
+	else
+	{
+		/* the main thread is never pinned so its mask is used to undo a previous pinning */
+		if (settings.cpuCore >= 0)
+			CPU_SET(settings.cpuCore, &cpuSet);
+		else if (sched_getaffinity(getpid(), sizeof(cpuSet), &cpuSet) != 0)
+			for (int32_t i = 0; i < getCoreCount(); i++)
+				CPU_SET(i, &cpuSet);
+
+		int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (error != 0)
+		{
+			errorMsg += "Could not set CPU affinity: " + std::string(strerror(error)) + ". ";
+			result = false;
+		}
+	}
+
+	int policy = SCHED_OTHER;
+	if (settings.policy == Policy::FIFO)
+		policy = SCHED_FIFO;
+	else if (settings.policy == Policy::ROUND_ROBIN)
+		policy = SCHED_RR;
+
+	sched_param param{};
+	param.sched_priority = std::clamp(settings.priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+
+	int error = pthread_setschedparam(pthread_self(), policy, &param);
+	if (error != 0)
+	{
+		errorMsg += "Could not set real-time priority: " + std::string(strerror(error)) + ", default scheduling is used.";
+		param.sched_priority = 0;
+		pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+		result = false;
+	}
+
+	return result;
+}
+#else
+bool ThreadPriority::apply(const Settings& settings, std::string& errorMsg)
+{
+	errorMsg.clear();
+	if (settings.policy == Policy::DEFAULT && settings.cpuCore < 0)
+		return true;
+
+	errorMsg = "Thread priority and CPU affinity are supported on Linux only, default scheduling is used.";
+	return false;
+}
+#endif
@@ -0,0 +1,34 @@
+#ifndef _THREADPRIORITY_HPP
+#define _THREADPRIORITY_HPP
+
+#include <cstdint>
+#include <string>
+
+/* Scheduling policy and CPU affinity of the acquisition threads. Real-time policies need CAP_SYS_NICE or a matching RLIMIT_RTPRIO,
+   without them the thread keeps the default scheduling and the reason is returned in errorMsg. */
+class ThreadPriority
+{
+   public:
+	enum class Policy : uint8_t
+	{
+		DEFAULT = 0,
+		FIFO = 1,
+		ROUND_ROBIN = 2,
+	};
+
+	struct Settings
+	{
+		Policy policy = Policy::DEFAULT;
+		/* clamped to the range of the selected policy */
+		int32_t priority = 50;
+		/* -1 leaves the thread on all cores the process may use */
+		int32_t cpuCore = -1;
+	};
+
+	/* applies the settings to the calling thread, returns false if any part could not be applied */
+	static bool apply(const Settings& settings, std::string& errorMsg);
+	static bool isSupported();
+	static int32_t getCoreCount();
+};
+
+#endif
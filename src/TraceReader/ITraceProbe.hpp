@@ -3,8 +3,11 @@
 
 #include <stdint.h>
 
+#include <string>
 #include <vector>
 
+#include "ProbeStatistics.hpp"
+
 class ITraceProbe
 {
    public:
@@ -18,12 +21,22 @@ class ITraceProbe
 	} TraceProbeSettings;
 
 	virtual ~ITraceProbe() = default;
+	/* the probe session is kept open between traces and reused when the settings did not change and the target still
+	   responds. Stop only ends the trace */
 	virtual bool startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset) = 0;
 	virtual bool stopTrace() = 0;
+	/* closes the kept session */
+	virtual void disconnect() {}
 	virtual int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) = 0;
 
 	virtual std::string getTargetName() = 0;
 	virtual std::vector<std::string> getConnectedDevices() = 0;
+
+	/* per-call latency and failures of readTraceBuffer */
+	ProbeStatistics& getStatistics() { return statistics; }
+
+   protected:
+	ProbeStatistics statistics;
 };
 
 #endif
\ No newline at end of file
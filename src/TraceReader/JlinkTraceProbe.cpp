@@ -1,5 +1,6 @@
 #include "JlinkTraceProbe.hpp"
 
+#include <chrono>
 #include <cstring>
 #include <random>
 
@@ -9,6 +10,11 @@ JlinkTraceProbe::JlinkTraceProbe(spdlog::logger* logger) : logger(logger)
 {
 }
 
+JlinkTraceProbe::~JlinkTraceProbe()
+{
+	disconnect();
+}
+
 bool JlinkTraceProbe::stopTrace()
 {
 	if (JLINKARM_SWO_Control(JLINKARM_SWO_CMD_STOP, nullptr) == -1)
@@ -17,13 +23,57 @@ bool JlinkTraceProbe::stopTrace()
 		return false;
 	}
 
-	JLINKARM_Close();
+	/* the session is kept for the next trace */
 	logger->info("Trace stopped.");
 	return true;
 }
 
+void JlinkTraceProbe::disconnect()
+{
+	if (!isSessionOpen)
+		return;
+
+	JLINKARM_Close();
+	isSessionOpen = false;
+}
+
+bool JlinkTraceProbe::isSessionAlive()
+{
+	uint32_t dhcsr = 0;
+	return JLINKARM_IsOpen() && JLINKARM_ReadMemEx(dhcsrAddress, sizeof(dhcsr), &dhcsr, 0) >= 0;
+}
+
 bool JlinkTraceProbe::startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset)
 {
+	if (isSessionOpen && (probeSettings.serialNumber != sessionSerialNumber || probeSettings.device != sessionDevice || probeSettings.speedkHz != sessionSpeedkHz || !isSessionAlive()))
+	{
+		logger->info("J-Link session cannot be reused, reconnecting");
+		disconnect();
+	}
+
+	if (!isSessionOpen && !openSession(probeSettings))
+		return false;
+
+	/* turn on relative timestamping */
+	JLINKARM_SWO_Config("TSEnable=1");
+
+	/* calculate SWO speed */
+	const uint32_t traceFrequency = coreFrequency / (tracePrescaler + 1);
+	int32_t result = JLINKARM_SWO_EnableTarget(coreFrequency, traceFrequency, JLINKARM_SWO_IF_UART, activeChannelMask);
+
+	if (result == 0)
+	{
+		logger->info("Starting Jlink reader thread!");
+		return true;
+	}
+
+	logger->info("Error starting Jlink reader thread! Error code {}", result);
+	return true;
+}
+
+bool JlinkTraceProbe::openSession(const TraceProbeSettings& probeSettings)
+{
+	auto start = std::chrono::steady_clock::now();
 	int32_t serialNumberInt = std::atoi(probeSettings.serialNumber.c_str());
 	std::string lastErrorMsg = "";
 
@@ -61,28 +111,21 @@ bool JlinkTraceProbe::startTrace(const TraceProbeSettings& probeSettings, uint32
 		return false;
 	}
 
-	/* turn on relative timestamping */
-	JLINKARM_SWO_Config("TSEnable=1");
-
-	/* calculate SWO speed */
-	const uint32_t traceFrequency = coreFrequency / (tracePrescaler + 1);
-	int32_t result = JLINKARM_SWO_EnableTarget(coreFrequency, traceFrequency, JLINKARM_SWO_IF_UART, activeChannelMask);
-
-	if (result == 0)
-	{
-		logger->info("Starting Jlink reader thread!");
-		return true;
-	}
-
-	logger->info("Error starting Jlink reader thread! Error code {}", result);
+	isSessionOpen = true;
+	sessionSerialNumber = probeSettings.serialNumber;
+	sessionDevice = probeSettings.device;
+	sessionSpeedkHz = probeSettings.speedkHz;
+	logger->info("J-Link connected in {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 	return true;
 }
 
 int32_t JlinkTraceProbe::readTraceBuffer(uint8_t* buffer, uint32_t size)
 {
 	/* TODO error handling of these two functions? */
+	const auto start = ProbeStatistics::Clock::now();
 	JLINKARM_SWO_Read(buffer, 0, &size);
 	JLINKARM_SWO_Control(JLINKARM_SWO_CMD_FLUSH, &size);
+	statistics.record(ProbeStatistics::Operation::READ_TRACE, start, true);
 	return size;
 }
 
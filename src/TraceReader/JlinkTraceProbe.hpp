@@ -11,16 +11,28 @@ class JlinkTraceProbe : public ITraceProbe
 {
    public:
 	explicit JlinkTraceProbe(spdlog::logger* logger);
+	~JlinkTraceProbe();
 	bool startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset) override;
 	bool stopTrace() override;
+	void disconnect() override;
 	int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) override;
 
 	std::string getTargetName() override;
 	std::vector<std::string> getConnectedDevices() override;
 
    private:
+	bool openSession(const TraceProbeSettings& probeSettings);
+	bool isSessionAlive();
+
 	static constexpr uint32_t maxSpeedkHz = 50000;
 	static constexpr size_t maxDevices = 10;
+	static constexpr uint32_t dhcsrAddress = 0xE000EDF0;
+
+	/* settings the open session was created with */
+	bool isSessionOpen = false;
+	std::string sessionSerialNumber;
+	std::string sessionDevice;
+	uint32_t sessionSpeedkHz = 0;
 	spdlog::logger* logger;
 };
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "StlinkTraceProbe.hpp"
 
+#include <chrono>
 #include <cstring>
 #include <random>
 
@@ -11,27 +12,60 @@ StlinkTraceProbe::StlinkTraceProbe(spdlog::logger* logger) : logger(logger)
 	// init_chipids(const_cast<char*>("./chips"));
 }
 
+StlinkTraceProbe::~StlinkTraceProbe()
+{
+	disconnect();
+}
+
 bool StlinkTraceProbe::stopTrace()
 {
 	if (sl == nullptr)
 		return false;
 
-	stlink_exit_debug_mode(sl);
+	/* the session is kept for the next trace */
 	stlink_trace_disable(sl);
-	stlink_close(sl);
 
 	logger->info("Trace stopped.");
 	return true;
 }
 
+void StlinkTraceProbe::disconnect()
+{
+	if (sl == nullptr)
+		return;
+
+	stlink_exit_debug_mode(sl);
+	stlink_close(sl);
+	sl = nullptr;
+}
+
+bool StlinkTraceProbe::isSessionAlive()
+{
+	uint32_t dhcsr = 0;
+	return stlink_read_debug32(sl, STLINK_REG_DHCSR, &dhcsr) == 0;
+}
+
 bool StlinkTraceProbe::startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset)
 {
-	sl = stlink_open_usb(UINFO, CONNECT_HOT_PLUG, NULL, probeSettings.speedkHz);
+	if (sl != nullptr && (probeSettings.speedkHz != sessionSpeedkHz || !isSessionAlive()))
+	{
+		logger->info("STLink session cannot be reused, reconnecting");
+		disconnect();
+	}
 
 	if (sl == nullptr)
 	{
-		logger->error("Stlink not found!");
-		return false;
+		auto start = std::chrono::steady_clock::now();
+		sl = stlink_open_usb(UINFO, CONNECT_HOT_PLUG, NULL, probeSettings.speedkHz);
+
+		if (sl == nullptr)
+		{
+			logger->error("Stlink not found!");
+			return false;
+		}
+
+		sessionSpeedkHz = probeSettings.speedkHz;
+		logger->info("STLink connected in {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 	}
 
 	if (shouldReset)
@@ -85,7 +119,10 @@ int32_t StlinkTraceProbe::readTraceBuffer(uint8_t* buffer, uint32_t size)
 	if (sl == nullptr)
 		return -1;
 
-	return stlink_trace_read(sl, buffer, size);
+	const auto start = ProbeStatistics::Clock::now();
+	int32_t result = stlink_trace_read(sl, buffer, size);
+	statistics.record(ProbeStatistics::Operation::READ_TRACE, start, result >= 0);
+	return result;
 }
 
 std::vector<std::string> StlinkTraceProbe::getConnectedDevices()
@@ -11,15 +11,21 @@ class StlinkTraceProbe : public ITraceProbe
 {
    public:
 	explicit StlinkTraceProbe(spdlog::logger* logger);
+	~StlinkTraceProbe();
 	bool startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset) override;
 	bool stopTrace() override;
+	void disconnect() override;
 	int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) override;
 
 	std::string getTargetName() override { return std::string(); }
 	std::vector<std::string> getConnectedDevices() override;
 
    private:
+	bool isSessionAlive();
+
 	stlink_t* sl = nullptr;
+	/* speed the open session was created with */
+	uint32_t sessionSpeedkHz = 0;
 	spdlog::logger* logger;
 };
 #endif
\ No newline at end of file
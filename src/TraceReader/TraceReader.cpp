@@ -113,6 +113,12 @@ void TraceReader::setTraceTimeout(uint32_t timeout)
 	traceTimeout = timeout;
 }
 
+void TraceReader::setThreadPriority(const ThreadPriority::Settings& settings)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	threadPriority = settings;
+}
+
 std::vector<std::string> TraceReader::getConnectedDevices() const
 {
 	std::lock_guard<std::mutex> lock(mtx);
@@ -122,9 +128,25 @@ std::vector<std::string> TraceReader::getConnectedDevices() const
 void TraceReader::changeDevice(std::shared_ptr<ITraceProbe> newTraceProbe)
 {
 	std::lock_guard<std::mutex> lock(mtx);
+	/* the session of the previous probe would keep its device claimed */
+	if (TraceProbe != nullptr && TraceProbe != newTraceProbe && !isRunning)
+		TraceProbe->disconnect();
 	TraceProbe = newTraceProbe;
 }
 
+ProbeStatistics* TraceReader::getProbeStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return TraceProbe == nullptr ? nullptr : &TraceProbe->getStatistics();
+}
+
+void TraceReader::disconnect()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning && TraceProbe != nullptr)
+		TraceProbe->disconnect();
+}
+
 std::string TraceReader::getTargetName()
 {
 	std::lock_guard<std::mutex> lock(mtx);
@@ -280,6 +302,15 @@ TraceReader::TraceState TraceReader::updateTrace(uint8_t c)
 
 void TraceReader::readerThread()
 {
+	std::string threadErrorMsg;
+	ThreadPriority::Settings settings;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		settings = threadPriority;
+	}
+	if (!ThreadPriority::apply(settings, threadErrorMsg))
+		logger->warn("Trace reader thread: {}", threadErrorMsg);
+
 	while (isRunning)
 	{
 		int32_t length = TraceProbe->readTraceBuffer(buffer, size);
@@ -9,6 +9,7 @@
 
 #include "ITraceProbe.hpp"
 #include "RingBufferBlocking.hpp"
+#include "ThreadPriority.hpp"
 #include "spdlog/spdlog.h"
 
 class TraceReader
@@ -42,10 +43,15 @@ class TraceReader
 	uint32_t getTraceFrequency() const;
 	void setTraceShouldReset(bool shouldReset);
 	void setTraceTimeout(uint32_t timeout);
+	/* applied by the reader thread on every start */
+	void setThreadPriority(const ThreadPriority::Settings& settings);
 
 	std::vector<std::string> getConnectedDevices() const;
 	void changeDevice(std::shared_ptr<ITraceProbe> newTraceProbe);
+	/* closes the probe session kept between acquisitions */
+	void disconnect();
 	std::string getTargetName();
+	ProbeStatistics* getProbeStatistics() const;
 
 	TraceIndicators getTraceIndicators() const;
 
@@ -84,6 +90,7 @@ class TraceReader
 	uint32_t tracePrescaler = 10;
 	uint32_t traceTimeout = 2;
 	bool shouldReset = false;
+	ThreadPriority::Settings threadPriority{};
 
 	std::atomic<bool> isRunning{false};
 	std::string lastErrorMsg = "";
@@ -1,6 +1,9 @@
 #include "Variable.hpp"
 
+#include <functional>
 #include <limits>
+#include <sstream>
+#include <unordered_map>
 
 const char* Variable::types[8] = {"unknown",
 								  "uint8_t",
@@ -345,4 +348,128 @@ void Variable::setIsCurrentlySampled(bool isCurrentlySampled)
 bool Variable::getIsCurrentlySampled() const
 {
 	return isCurrentlySampled;
-}
\ No newline at end of file
+}
+
+void Variable::setPointerOffsets(const std::vector<int32_t>& offsets)
+{
+	pointerOffsets = offsets;
+	resolution.word = 0;
+}
+
+std::vector<int32_t> Variable::getPointerOffsets() const
+{
+	return pointerOffsets;
+}
+
+bool Variable::setPointerOffsetsFromString(const std::string& offsets)
+{
+	std::vector<int32_t> result;
+	std::istringstream stream(offsets);
+	std::string token;
+
+	while (std::getline(stream, token, ','))
+	{
+		token.erase(0, token.find_first_not_of(" \t"));
+		token.erase(token.find_last_not_of(" \t") + 1);
+
+		if (token.empty())
+			continue;
+
+		try
+		{
+			size_t parsed = 0;
+			result.push_back(static_cast<int32_t>(std::stol(token, &parsed, 0)));
+			if (parsed != token.size())
+				return false;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	setPointerOffsets(result);
+	return true;
+}
+
+std::string Variable::getPointerOffsetsString() const
+{
+	std::string result;
+
+	for (size_t i = 0; i < pointerOffsets.size(); i++)
+	{
+		if (i > 0)
+			result += ",";
+		result += std::to_string(pointerOffsets[i]);
+	}
+	return result;
+}
+
+bool Variable::isPointerChain() const
+{
+	return !pointerOffsets.empty();
+}
+
+bool Variable::isAddressResolved() const
+{
+	return !isPointerChain() || (resolution.word & Resolution::resolvedFlag);
+}
+
+bool Variable::resolveAddress(const std::function<bool(uint32_t address, uint32_t& pointer)>& readPointer)
+{
+	uint32_t currentAddress = address;
+
+	for (auto offset : pointerOffsets)
+	{
+		uint32_t pointer = 0;
+		if (!readPointer(currentAddress, pointer) || pointer == 0)
+		{
+			resolution.word &= ~Resolution::resolvedFlag;
+			return false;
+		}
+		currentAddress = pointer + offset;
+	}
+
+	resolution.word = Resolution::resolvedFlag | currentAddress;
+	return true;
+}
+
+uint32_t Variable::getSampleAddress() const
+{
+	return isPointerChain() ? static_cast<uint32_t>(resolution.word) : address;
+}
+
+std::vector<Variable*> Variable::sortByBaseDependency(const std::vector<Variable*>& variables, std::vector<Variable*>& cyclic)
+{
+	enum class Mark
+	{
+		VISITING,
+		DONE,
+	};
+
+	std::vector<Variable*> sorted;
+	std::unordered_map<Variable*, Mark> marks;
+
+	std::function<void(Variable*)> visit = [&](Variable* var)
+	{
+		auto mark = marks.find(var);
+		if (mark != marks.end())
+		{
+			if (mark->second == Mark::VISITING)
+				cyclic.push_back(var);
+			return;
+		}
+
+		marks[var] = Mark::VISITING;
+		if (var->getFractional().baseVariable != nullptr)
+			visit(var->getFractional().baseVariable);
+		marks[var] = Mark::DONE;
+		sorted.push_back(var);
+	};
+
+	for (auto var : variables)
+		if (var != nullptr)
+			visit(var);
+
+	return sorted;
+}
@@ -1,9 +1,11 @@
 #ifndef __VARIABLE_HPP
 #define __VARIABLE_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 class Variable
 {
@@ -97,6 +99,24 @@ class Variable
 	void setIsCurrentlySampled(bool isCurrentlySampled);
 	bool getIsCurrentlySampled() const;
 
+	/* pointer chain - address holds the root pointer and every offset is added to the pointer read at the previous level */
+	void setPointerOffsets(const std::vector<int32_t>& offsets);
+	std::vector<int32_t> getPointerOffsets() const;
+	bool setPointerOffsetsFromString(const std::string& offsets);
+	std::string getPointerOffsetsString() const;
+	bool isPointerChain() const;
+	bool isAddressResolved() const;
+
+	/* walks the chain using readPointer, returns false if any pointer could not be read or is null */
+	bool resolveAddress(const std::function<bool(uint32_t address, uint32_t& pointer)>& readPointer);
+
+	/* address the value is sampled from - differs from getAddress() for pointer chains only */
+	uint32_t getSampleAddress() const;
+
+	/* orders variables so that fractional bases go before the variables using them, bases missing from the input are appended in place.
+	   Variables whose base chain loops back to them are stored in cyclic and evaluated with the previous base value. */
+	static std::vector<Variable*> sortByBaseDependency(const std::vector<Variable*>& variables, std::vector<Variable*>& cyclic);
+
    public:
 	static const char* types[8];
 	static const char* highLevelTypes[3];
@@ -121,6 +141,26 @@ class Variable
 	bool shouldUpdateFromElf = true;
 	bool isTrackedNameDifferent = false;
 	bool isCurrentlySampled = false;
+
+	/* resolved by the acquisition thread while the GUI and the processing stage read it - the address and the
+	   resolved flag are published as a single word so that a new address is never seen with a stale flag */
+	struct Resolution
+	{
+		static constexpr uint64_t resolvedFlag = 1ull << 32;
+
+		Resolution() = default;
+		Resolution(const Resolution& other) : word(other.word.load()) {}
+		Resolution& operator=(const Resolution& other)
+		{
+			word = other.word.load();
+			return *this;
+		}
+
+		std::atomic<uint64_t> word = 0;
+	};
+
+	std::vector<int32_t> pointerOffsets;
+	Resolution resolution;
 };
 
 #endif
\ No newline at end of file
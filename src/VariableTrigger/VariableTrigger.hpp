@@ -0,0 +1,98 @@
+#ifndef _VARIABLETRIGGER_HPP
+#define _VARIABLETRIGGER_HPP
+
+#include <cstdint>
+#include <string>
+
+/* Trigger condition evaluated on every sample of a single variable */
+class VariableTrigger
+{
+   public:
+	enum class Type : uint8_t
+	{
+		DISABLED = 0,
+		LEVEL = 1,
+		RISING_EDGE = 2,
+		FALLING_EDGE = 3,
+		BITMASK = 4,
+		CHANGE = 5,
+	};
+
+	typedef struct Settings
+	{
+		Type type = Type::DISABLED;
+		std::string variableName = "";
+		double level = 0.0;
+		/* BITMASK triggers when (raw & mask) == (value & mask) */
+		uint32_t mask = 0xffffffff;
+		uint32_t value = 0;
+		uint32_t preTriggerPoints = 1000;
+		uint32_t postTriggerPoints = 1000;
+		bool rearm = false;
+	} Settings;
+
+	VariableTrigger() = default;
+	explicit VariableTrigger(const Settings& settings) : settings(settings) {}
+
+	void setSettings(const Settings& newSettings)
+	{
+		settings = newSettings;
+		reset();
+	}
+
+	Settings getSettings() const
+	{
+		return settings;
+	}
+
+	bool isEnabled() const
+	{
+		return settings.type != Type::DISABLED;
+	}
+
+	/* forget the previous sample so that edges are not detected across acquisitions */
+	void reset()
+	{
+		hasPrevious = false;
+	}
+
+	/* value is the converted variable value, raw is the memory word it was converted from */
+	bool check(double value, uint32_t raw)
+	{
+		bool result = false;
+
+		switch (settings.type)
+		{
+			case Type::LEVEL:
+				result = value > settings.level;
+				break;
+			case Type::RISING_EDGE:
+				result = hasPrevious && previousValue <= settings.level && value > settings.level;
+				break;
+			case Type::FALLING_EDGE:
+				result = hasPrevious && previousValue >= settings.level && value < settings.level;
+				break;
+			case Type::BITMASK:
+				result = (raw & settings.mask) == (settings.value & settings.mask);
+				break;
+			case Type::CHANGE:
+				result = hasPrevious && raw != previousRaw;
+				break;
+			default:
+				break;
+		}
+
+		hasPrevious = true;
+		previousValue = value;
+		previousRaw = raw;
+		return result;
+	}
+
+   private:
+	Settings settings{};
+	bool hasPrevious = false;
+	double previousValue = 0.0;
+	uint32_t previousRaw = 0;
+};
+
+#endif
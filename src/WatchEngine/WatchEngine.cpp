@@ -0,0 +1,157 @@
+#include "WatchEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void WatchEngine::setWatches(const std::vector<Watch>& newWatches)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	watches = newWatches;
+}
+
+std::vector<WatchEngine::Watch> WatchEngine::getWatches() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return watches;
+}
+
+size_t WatchEngine::compile(const std::function<int32_t(const std::string& variableName)>& resolveSlot)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	compiled.clear();
+
+	for (auto& watch : watches)
+	{
+		if (!watch.enabled)
+			continue;
+
+		int32_t slot = resolveSlot(watch.variableName);
+		if (slot < 0)
+			continue;
+
+		CompiledWatch compiledWatch{};
+		compiledWatch.slot = slot;
+		compiledWatch.condition = watch.condition;
+		compiledWatch.threshold = watch.threshold;
+		compiledWatch.mask = watch.mask;
+		compiledWatch.maskedValue = static_cast<uint32_t>(std::llround(watch.threshold)) & watch.mask;
+		compiledWatch.debounceSamples = std::max(1u, watch.debounceSamples);
+		compiledWatch.stopAcquisition = watch.stopAcquisition;
+		compiledWatch.name = watch.name;
+		compiledWatch.variableName = watch.variableName;
+
+		if (watch.condition == Condition::GREATER)
+			compiledWatch.releaseThreshold = watch.threshold - std::abs(watch.hysteresis);
+		else if (watch.condition == Condition::LESS)
+			compiledWatch.releaseThreshold = watch.threshold + std::abs(watch.hysteresis);
+		else
+			compiledWatch.releaseThreshold = watch.threshold;
+
+		compiled.push_back(std::move(compiledWatch));
+	}
+
+	return compiled.size();
+}
+
+bool WatchEngine::isMet(const CompiledWatch& watch, double value)
+{
+	switch (watch.condition)
+	{
+		case Condition::GREATER:
+			return value > watch.threshold;
+		case Condition::LESS:
+			return value < watch.threshold;
+		case Condition::EQUAL:
+			return value == watch.threshold;
+		case Condition::NOT_EQUAL:
+			return value != watch.threshold;
+		case Condition::BITMASK:
+			return (static_cast<uint32_t>(static_cast<int64_t>(value)) & watch.mask) == watch.maskedValue;
+		default:
+			return false;
+	}
+}
+
+bool WatchEngine::isReleased(const CompiledWatch& watch, double value)
+{
+	switch (watch.condition)
+	{
+		case Condition::GREATER:
+			return value <= watch.releaseThreshold;
+		case Condition::LESS:
+			return value >= watch.releaseThreshold;
+		default:
+			return !isMet(watch, value);
+	}
+}
+
+bool WatchEngine::process(double timestamp, const std::vector<double>& values)
+{
+	bool shouldStop = false;
+
+	for (auto& watch : compiled)
+	{
+		if (static_cast<size_t>(watch.slot) >= values.size())
+			continue;
+
+		const double value = values[watch.slot];
+
+		watch.history[watch.historyHead] = value;
+		watch.historyHead = (watch.historyHead + 1) % contextSamples;
+		watch.historySize = std::min(watch.historySize + 1, contextSamples);
+
+		if (watch.active)
+		{
+			if (isReleased(watch, value))
+			{
+				watch.active = false;
+				watch.matchingSamples = 0;
+			}
+			continue;
+		}
+
+		if (!isMet(watch, value))
+		{
+			watch.matchingSamples = 0;
+			continue;
+		}
+
+		if (++watch.matchingSamples < watch.debounceSamples)
+			continue;
+
+		watch.active = true;
+		addEvent(watch, timestamp, value);
+		shouldStop |= watch.stopAcquisition;
+	}
+
+	return shouldStop;
+}
+
+void WatchEngine::addEvent(const CompiledWatch& watch, double timestamp, double value)
+{
+	Event event{watch.name, watch.variableName, timestamp, value, {}};
+	event.context.reserve(watch.historySize);
+
+	const size_t oldest = (watch.historyHead + contextSamples - watch.historySize) % contextSamples;
+	for (size_t i = 0; i < watch.historySize; i++)
+		event.context.push_back(watch.history[(oldest + i) % contextSamples]);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	if (events.size() >= maxEvents)
+		events.pop_front();
+	events.push_back(std::move(event));
+	eventCount++;
+}
+
+std::vector<WatchEngine::Event> WatchEngine::getEvents() const
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return std::vector<Event>(events.begin(), events.end());
+}
+
+void WatchEngine::clearEvents()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	events.clear();
+	eventCount = 0;
+}
@@ -0,0 +1,104 @@
+#ifndef _WATCHENGINE_HPP
+#define _WATCHENGINE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Evaluates user defined conditions on every acquired sample. Watches are edited as plain settings and compiled
+   into flat predicates at acquisition start, so that the sample loop does no lookups nor allocations. */
+class WatchEngine
+{
+   public:
+	enum class Condition : uint8_t
+	{
+		GREATER = 0,
+		LESS = 1,
+		EQUAL = 2,
+		NOT_EQUAL = 3,
+		BITMASK = 4,
+	};
+
+	struct Watch
+	{
+		std::string name = "";
+		std::string variableName = "";
+		Condition condition = Condition::GREATER;
+		/* for BITMASK the hit happens when (value & mask) == threshold */
+		double threshold = 0.0;
+		/* GREATER and LESS only - the watch is released after the value moves back by the hysteresis */
+		double hysteresis = 0.0;
+		uint32_t mask = 0xffffffff;
+		/* number of consecutive samples that have to meet the condition */
+		uint32_t debounceSamples = 1;
+		bool stopAcquisition = false;
+		bool enabled = true;
+	};
+
+	struct Event
+	{
+		std::string watchName;
+		std::string variableName;
+		double timestamp;
+		double value;
+		/* samples preceding the hit, oldest first, the last one is the hit itself */
+		std::vector<double> context;
+	};
+
+	static constexpr size_t maxEvents = 1000;
+	static constexpr size_t contextSamples = 32;
+	static constexpr const char* conditions[] = {">", "<", "==", "!=", "& mask =="};
+
+	void setWatches(const std::vector<Watch>& newWatches);
+	std::vector<Watch> getWatches() const;
+
+	/* binds enabled watches to value slots, watches resolved to -1 are skipped; returns the number of compiled watches */
+	size_t compile(const std::function<int32_t(const std::string& variableName)>& resolveSlot);
+	bool isEmpty() const { return compiled.empty(); }
+
+	/* evaluates every compiled watch, values are indexed by slot; returns true if a hit requested stopping the acquisition */
+	bool process(double timestamp, const std::vector<double>& values);
+
+	std::vector<Event> getEvents() const;
+	uint64_t getEventCount() const { return eventCount; }
+	void clearEvents();
+
+   private:
+	struct CompiledWatch
+	{
+		int32_t slot;
+		Condition condition;
+		double threshold;
+		double releaseThreshold;
+		uint32_t mask;
+		uint32_t maskedValue;
+		uint32_t debounceSamples;
+		bool stopAcquisition;
+
+		uint32_t matchingSamples = 0;
+		bool active = false;
+		std::array<double, contextSamples> history{};
+		size_t historyHead = 0;
+		size_t historySize = 0;
+
+		std::string name;
+		std::string variableName;
+	};
+
+	static bool isMet(const CompiledWatch& watch, double value);
+	static bool isReleased(const CompiledWatch& watch, double value);
+	void addEvent(const CompiledWatch& watch, double timestamp, double value);
+
+	std::vector<Watch> watches;
+	std::vector<CompiledWatch> compiled;
+	std::deque<Event> events;
+	std::atomic<uint64_t> eventCount = 0;
+	mutable std::mutex mtx;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "CLI11.hpp"
 #include "ConfigHandler.hpp"
 #include "Gui.hpp"
+#include "Headless.hpp"
 #include "NFDFileHandler.hpp"
 #include "VariableHandler.hpp"
 #include "gitversion.hpp"
@@ -18,18 +19,21 @@ std::mutex mtx;
 std::shared_ptr<spdlog::logger> logger;
 CLI::App app{"MCUViewer"};
 
-void prepareLogger();
-void prepareCLIParser(bool& debug, std::string& projectPath);
+void prepareLogger(bool logToStderr);
+void prepareCLIParser(bool& debug, std::string& projectPath, bool& headless, Headless::Settings& headlessSettings);
 
 int main(int argc, char** argv)
 {
 	bool debug = false;
+	bool headless = false;
 	std::string projectPath = "";
-	prepareCLIParser(debug, projectPath);
+	Headless::Settings headlessSettings{};
+	prepareCLIParser(debug, projectPath, headless, headlessSettings);
 
 	CLI11_PARSE(app, argc, argv);
 
-	prepareLogger();
+	/* stdout carries the samples when streaming to it */
+	prepareLogger(headless && headlessSettings.format == CSVStreamer::Format::STDOUT);
 
 	if (debug)
 		logger->set_level(spdlog::level::debug);
@@ -51,6 +55,19 @@ int main(int argc, char** argv)
 	TraceDataHandler traceDataHandler(&plotGroupHandler, &variableHandler, &plotHandler, &tracePlotHandler, done, &mtx, loggerPtr);
 
 	ConfigHandler configHandler("", &plotHandler, &tracePlotHandler, &plotGroupHandler, &variableHandler, &viewerDataHandler, &traceDataHandler, loggerPtr);
+
+	if (headless)
+	{
+		headlessSettings.projectPath = projectPath;
+		Headless headlessRunner(&configHandler, &variableHandler, &plotHandler, &viewerDataHandler, &traceDataHandler, loggerPtr);
+		int result = headlessRunner.run(headlessSettings);
+
+		done = true;
+		logger->info("Closing MCUViewer!");
+		logger->flush();
+		return result;
+	}
+
 	NFDFileHandler fileHandler;
 
 	Gui gui(&plotHandler, &variableHandler, &configHandler, &plotGroupHandler, &fileHandler, &tracePlotHandler, &viewerDataHandler, &traceDataHandler, done, &mtx, loggerPtr, projectPath);
@@ -65,7 +82,7 @@ int main(int argc, char** argv)
 	return 0;
 }
 
-void prepareLogger()
+void prepareLogger(bool logToStderr)
 {
 #if defined(__APPLE__) || defined(_UNIX)
 	std::string logDirectory = std::string(std::getenv("HOME")) + "/MCUViewer/logs/logfile.txt";
@@ -75,16 +92,38 @@ void prepareLogger()
 #error "Your system is not supported!"
 #endif
 
-	spdlog::sinks_init_list sinkList = {std::make_shared<spdlog::sinks::stdout_color_sink_mt>(),
+	std::shared_ptr<spdlog::sinks::sink> consoleSink;
+	if (logToStderr)
+		consoleSink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+	else
+		consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+	spdlog::sinks_init_list sinkList = {consoleSink,
 										std::make_shared<spdlog::sinks::rotating_file_sink_mt>(logDirectory, 5 * 1024 * 1024, 10)};
 	logger = std::make_shared<spdlog::logger>("logger", sinkList.begin(), sinkList.end());
 	spdlog::register_logger(logger);
 }
 
-void prepareCLIParser(bool& debug, std::string& projectPath)
+void prepareCLIParser(bool& debug, std::string& projectPath, bool& headless, Headless::Settings& headlessSettings)
 {
 	app.fallthrough();
 	app.ignore_case();
 	app.add_flag("-d,--debug", debug, "Use for extra debug messages and logs");
 	app.add_option("-p,--project", projectPath, "Use to open a project directly from command line");
+
+	auto headlessFlag = app.add_flag("--headless", headless, "Run a single acquisition of the project (-p) without a window");
+	app.add_option("--view", headlessSettings.view, "Acquisition to run in headless mode")
+		->transform(CLI::CheckedTransformer(std::map<std::string, Headless::View>{{"var", Headless::View::VAR_VIEWER}, {"trace", Headless::View::TRACE_VIEWER}}, CLI::ignore_case))
+		->needs(headlessFlag);
+	app.add_option("--duration", headlessSettings.durationS, "Acquisition time in seconds, runs until stopped by Ctrl+C if not set")
+		->check(CLI::PositiveNumber)
+		->needs(headlessFlag);
+	app.add_flag("--until-trigger", headlessSettings.untilTrigger, "Stop after the first trigger configured in the project")
+		->needs(headlessFlag);
+	app.add_option("--output", headlessSettings.format, "Output format: csv and binary files are written to the log directory")
+		->transform(CLI::CheckedTransformer(std::map<std::string, CSVStreamer::Format>{{"csv", CSVStreamer::Format::CSV}, {"binary", CSVStreamer::Format::BINARY}, {"stdout", CSVStreamer::Format::STDOUT}}, CLI::ignore_case))
+		->needs(headlessFlag);
+	app.add_option("--output-dir", headlessSettings.outputDirectory, "Overrides the log directory of the project")
+		->check(CLI::ExistingDirectory)
+		->needs(headlessFlag);
 }
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "CycleCounter.hpp"
+
+TEST(CycleCounterTest, testFirstSampleIsZero)
+{
+	CycleCounter counter{1000000};
+
+	ASSERT_DOUBLE_EQ(counter.update(123456), 0.0);
+	ASSERT_NEAR(counter.update(123456 + 500000), 0.5, 10e-9);
+}
+
+TEST(CycleCounterTest, testRollover)
+{
+	CycleCounter counter{1000000};
+
+	counter.update(0xffffff00);
+	ASSERT_NEAR(counter.update(0x00000100), 512.0 / 1000000.0, 10e-9);
+	ASSERT_NEAR(counter.update(0x00000100 + 1000000), 1.0 + 512.0 / 1000000.0, 10e-9);
+}
+
+TEST(CycleCounterTest, testReset)
+{
+	CycleCounter counter{1000};
+
+	counter.update(0);
+	counter.update(5000);
+	counter.reset();
+
+	ASSERT_DOUBLE_EQ(counter.update(10000), 0.0);
+	ASSERT_NEAR(counter.update(11000), 1.0, 10e-9);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "DecimatingBuffer.hpp"
+
+TEST(DecimatingBufferTest, testBuckets)
+{
+	DecimatingBuffer<double> buffer;
+	buffer.setFactor(4);
+
+	std::vector<double> values{1.0, 5.0, 2.0, 0.0, -3.0, 1.0, 1.0, 1.0, 7.0};
+	for (size_t i = 0; i < values.size(); i++)
+		buffer.addPoint(static_cast<double>(i), values[i]);
+
+	/* the last point is still in an incomplete bucket */
+	auto buckets = buffer.getLinearData();
+	ASSERT_EQ(buckets.size(), 2);
+
+	ASSERT_DOUBLE_EQ(buckets[0].time, 0.0);
+	ASSERT_DOUBLE_EQ(buckets[0].min, 0.0);
+	ASSERT_DOUBLE_EQ(buckets[0].max, 5.0);
+	ASSERT_DOUBLE_EQ(buckets[0].mean, 2.0);
+
+	ASSERT_DOUBLE_EQ(buckets[1].time, 4.0);
+	ASSERT_DOUBLE_EQ(buckets[1].min, -3.0);
+	ASSERT_DOUBLE_EQ(buckets[1].max, 1.0);
+	ASSERT_DOUBLE_EQ(buckets[1].mean, 0.0);
+}
+
+TEST(DecimatingBufferTest, testSpikeIsKept)
+{
+	DecimatingBuffer<double> buffer;
+	buffer.setFactor(1000);
+	buffer.setMaxSize(10);
+
+	for (size_t i = 0; i < 100000; i++)
+		buffer.addPoint(static_cast<double>(i), i == 54321 ? 100.0 : 0.0);
+
+	auto buckets = buffer.getLinearData();
+	ASSERT_EQ(buckets.size(), 10);
+	ASSERT_DOUBLE_EQ(buckets.front().time, 90000.0);
+
+	buffer.setMaxSize(100);
+	for (size_t i = 0; i < 100000; i++)
+		buffer.addPoint(static_cast<double>(i), i == 54321 ? 100.0 : 0.0);
+
+	buckets = buffer.getLinearData();
+	ASSERT_EQ(buckets.size(), 100);
+	ASSERT_DOUBLE_EQ(buckets[54].max, 100.0);
+	ASSERT_DOUBLE_EQ(buckets[54].mean, 0.1);
+	ASSERT_DOUBLE_EQ(buckets[53].max, 0.0);
+}
+
+TEST(DecimatingBufferTest, testCopyAndErase)
+{
+	DecimatingBuffer<double> buffer;
+	buffer.setFactor(2);
+	buffer.setMaxSize(3);
+
+	for (size_t i = 0; i < 8; i++)
+		buffer.addPoint(static_cast<double>(i), static_cast<double>(i));
+
+	buffer.copyData();
+	ASSERT_EQ(buffer.getSizeCopy(), 3);
+	ASSERT_EQ(buffer.getOffsetCopy(), 1);
+	/* the oldest bucket is at the offset */
+	ASSERT_DOUBLE_EQ(buffer.getFirstElementCopy()[buffer.getOffsetCopy()].time, 2.0);
+
+	buffer.erase();
+	ASSERT_EQ(buffer.getSize(), 0);
+}
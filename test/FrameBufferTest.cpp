@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "FrameBuffer.hpp"
+
+TEST(FrameBufferTest, testLatestFrame)
+{
+	FrameBuffer<double> buffer;
+
+	buffer.addFrame({1.0, 2.0, 3.0});
+	buffer.addFrame({4.0, 5.0, 6.0});
+
+	ASSERT_EQ(buffer.getFrameCount(), 1);
+	ASSERT_EQ(buffer.getFrameSize(), 3);
+	ASSERT_EQ(buffer.getFrame(0), std::vector<double>({4.0, 5.0, 6.0}));
+	ASSERT_EQ(buffer.getAverage(), std::vector<double>({4.0, 5.0, 6.0}));
+}
+
+TEST(FrameBufferTest, testPersistence)
+{
+	FrameBuffer<double> buffer;
+	buffer.setPersistence(3);
+
+	for (int i = 0; i < 5; i++)
+		buffer.addFrame({static_cast<double>(i), static_cast<double>(i)});
+
+	ASSERT_EQ(buffer.getFrameCount(), 3);
+	ASSERT_EQ(buffer.getFrame(0)[0], 4.0);
+	ASSERT_EQ(buffer.getFrame(2)[0], 2.0);
+
+	buffer.setPersistence(1);
+	ASSERT_EQ(buffer.getFrameCount(), 1);
+	ASSERT_EQ(buffer.getFrame(0)[0], 4.0);
+}
+
+TEST(FrameBufferTest, testRunningAverage)
+{
+	FrameBuffer<double> buffer;
+	buffer.setAveraging(4);
+
+	buffer.addFrame({2.0, 4.0});
+	buffer.addFrame({4.0, 8.0});
+	ASSERT_EQ(buffer.getAverage(), std::vector<double>({3.0, 6.0}));
+
+	for (int i = 0; i < 10; i++)
+		buffer.addFrame({static_cast<double>(i), 1.0});
+
+	/* last four frames are 6, 7, 8 and 9 */
+	ASSERT_DOUBLE_EQ(buffer.getAverage()[0], 7.5);
+	ASSERT_DOUBLE_EQ(buffer.getAverage()[1], 1.0);
+	/* averaging does not change the number of displayed frames */
+	ASSERT_EQ(buffer.getFrameCount(), 1);
+
+	buffer.setAveraging(2);
+	ASSERT_DOUBLE_EQ(buffer.getAverage()[0], 8.5);
+}
+
+TEST(FrameBufferTest, testFrameSizeChange)
+{
+	FrameBuffer<double> buffer;
+	buffer.setPersistence(4);
+	buffer.setAveraging(4);
+
+	buffer.addFrame({1.0, 1.0});
+	buffer.addFrame({3.0, 3.0});
+	buffer.addFrame({10.0, 20.0, 30.0});
+
+	ASSERT_EQ(buffer.getFrameCount(), 1);
+	ASSERT_EQ(buffer.getAverage(), std::vector<double>({10.0, 20.0, 30.0}));
+
+	buffer.erase();
+	ASSERT_EQ(buffer.getFrameCount(), 0);
+	ASSERT_EQ(buffer.getFrameSize(), 0);
+}
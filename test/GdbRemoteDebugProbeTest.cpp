@@ -0,0 +1,232 @@
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GdbRemoteDebugProbe.hpp"
+#include "spdlog/fmt/fmt.h"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+/* minimal gdbserver serving a RAM block at baseAddress */
+class StubServer
+{
+   public:
+	StubServer(bool supportsNoAck) : supportsNoAck(supportsNoAck)
+	{
+		for (size_t i = 0; i < memory.size(); i++)
+			memory[i] = static_cast<uint8_t>(i);
+
+		listener = socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = 0;
+		bind(listener, (sockaddr*)&address, sizeof(address));
+		listen(listener, 1);
+
+		socklen_t length = sizeof(address);
+		getsockname(listener, (sockaddr*)&address, &length);
+		port = ntohs(address.sin_port);
+
+		handle = std::thread(&StubServer::serve, this);
+	}
+
+	~StubServer()
+	{
+		shutdown(listener, SHUT_RDWR);
+		close(listener);
+		handle.join();
+	}
+
+	static constexpr uint32_t baseAddress = 0x20000000;
+	std::vector<uint8_t> memory = std::vector<uint8_t>(256);
+	uint16_t port = 0;
+	std::atomic<size_t> memoryPackets = 0;
+
+   private:
+	void serve()
+	{
+		int client = accept(listener, nullptr, nullptr);
+		if (client < 0)
+			return;
+
+		int flag = 1;
+		setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		std::string buffer;
+		char data[1024];
+		bool noAck = false;
+
+		while (true)
+		{
+			auto received = recv(client, data, sizeof(data), 0);
+			if (received <= 0)
+				break;
+			buffer.append(data, received);
+
+			while (true)
+			{
+				/* acknowledgements are skipped */
+				while (!buffer.empty() && buffer[0] != '$')
+					buffer.erase(0, 1);
+
+				auto end = buffer.find('#');
+				if (end == std::string::npos || buffer.size() < end + 3)
+					break;
+
+				std::string payload = buffer.substr(1, end - 1);
+				buffer.erase(0, end + 3);
+
+				if (!noAck)
+					send(client, "+", 1, 0);
+
+				std::string reply = handlePacket(payload);
+				if (payload == "QStartNoAckMode")
+					noAck = true;
+
+				uint8_t checksum = 0;
+				for (char c : reply)
+					checksum += c;
+				std::string packet = fmt::format("${}#{:02x}", reply, checksum);
+				send(client, packet.data(), packet.size(), 0);
+
+				if (payload == "D")
+				{
+					close(client);
+					return;
+				}
+			}
+		}
+		close(client);
+	}
+
+	std::string handlePacket(const std::string& payload)
+	{
+		if (payload.rfind("qSupported", 0) == 0)
+			return supportsNoAck ? "PacketSize=40;QStartNoAckMode+" : "PacketSize=40";
+		if (payload == "QStartNoAckMode" || payload == "D")
+			return "OK";
+		if (payload == "?")
+			return "T05";
+
+		uint32_t address = 0;
+		uint32_t length = 0;
+		if (payload[0] == 'm' && sscanf(payload.c_str(), "m%x,%x", &address, &length) == 2)
+		{
+			memoryPackets++;
+			if (address < baseAddress || address + length > baseAddress + memory.size())
+				return "E01";
+
+			std::string reply;
+			for (uint32_t i = 0; i < length; i++)
+				reply += fmt::format("{:02x}", memory[address - baseAddress + i]);
+			return reply;
+		}
+		if (payload[0] == 'M' && sscanf(payload.c_str(), "M%x,%x:", &address, &length) == 2)
+		{
+			auto data = payload.substr(payload.find(':') + 1);
+			for (uint32_t i = 0; i < length; i++)
+				memory[address - baseAddress + i] = std::stoul(data.substr(2 * i, 2), nullptr, 16);
+			return "OK";
+		}
+		return "";
+	}
+
+	bool supportsNoAck;
+	int listener = -1;
+	std::thread handle;
+};
+
+class GdbRemoteDebugProbeTest : public ::testing::TestWithParam<bool>
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("gdb", std::make_shared<spdlog::sinks::null_sink_mt>());
+		server = std::make_unique<StubServer>(GetParam());
+		probe = std::make_unique<GdbRemoteDebugProbe>(logger.get());
+
+		settings.serialNumber = "127.0.0.1:" + std::to_string(server->port);
+		ASSERT_TRUE(probe->startAcqusition(settings, sampleList, 100));
+	}
+
+	void TearDown() override
+	{
+		probe->stopAcqusition();
+		probe.reset();
+		server.reset();
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<StubServer> server;
+	std::unique_ptr<GdbRemoteDebugProbe> probe;
+	IDebugProbe::DebugProbeSettings settings{};
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{};
+};
+
+TEST_P(GdbRemoteDebugProbeTest, testReadWrite)
+{
+	uint32_t value = 0xffffffff;
+	ASSERT_TRUE(probe->readMemory(0x20000004, (uint8_t*)&value, 4));
+	ASSERT_EQ(value, 0x07060504);
+
+	value = 0xffffffff;
+	ASSERT_TRUE(probe->readMemory(0x20000011, (uint8_t*)&value, 1));
+	ASSERT_EQ(value, 0x11);
+
+	uint32_t written = 0xdeadbeef;
+	ASSERT_TRUE(probe->writeMemory(0x20000020, (uint8_t*)&written, 4));
+	ASSERT_TRUE(probe->readMemory(0x20000020, (uint8_t*)&value, 4));
+	ASSERT_EQ(value, 0xdeadbeef);
+
+	/* larger than the packet size allows, split into multiple packets */
+	std::vector<uint8_t> block(64);
+	ASSERT_TRUE(probe->readMemory(0x20000040, block.data(), block.size()));
+	for (size_t i = 0; i < block.size(); i++)
+		ASSERT_EQ(block[i], 0x40 + i);
+
+	ASSERT_FALSE(probe->readMemory(0x30000000, (uint8_t*)&value, 4));
+	ASSERT_FALSE(probe->getLastErrorMsg().empty());
+}
+
+TEST_P(GdbRemoteDebugProbeTest, testBatch)
+{
+	std::vector<std::pair<uint32_t, uint8_t>> reads{{0x20000000, 4}, {0x20000010, 2}, {0x20000033, 1}, {0x20000080, 4}};
+	std::vector<uint32_t> values(reads.size());
+
+	size_t packets = server->memoryPackets;
+	ASSERT_TRUE(probe->readMemoryBatch(reads, values.data()));
+	ASSERT_EQ(server->memoryPackets - packets, reads.size());
+
+	ASSERT_EQ(values[0], 0x03020100);
+	ASSERT_EQ(values[1], 0x1110);
+	ASSERT_EQ(values[2], 0x33);
+	ASSERT_EQ(values[3], 0x83828180);
+}
+
+TEST_P(GdbRemoteDebugProbeTest, testSessionKept)
+{
+	ASSERT_TRUE(probe->stopAcqusition());
+	uint32_t value = 0;
+	ASSERT_FALSE(probe->readMemory(0x20000004, (uint8_t*)&value, 4));
+
+	/* the stub accepts a single connection, so a restart only works on the kept session */
+	ASSERT_TRUE(probe->startAcqusition(settings, sampleList, 100));
+	ASSERT_TRUE(probe->readMemory(0x20000004, (uint8_t*)&value, 4));
+	ASSERT_EQ(value, 0x07060504);
+}
+
+INSTANTIATE_TEST_SUITE_P(AckModes, GdbRemoteDebugProbeTest, ::testing::Values(true, false));
+
+#endif
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+#include "ProbeStatistics.hpp"
+
+TEST(LatencyHistogramTest, testBucketBounds)
+{
+	for (uint64_t value : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull, (1ull << 39) + 5})
+	{
+		uint32_t index = LatencyHistogram::getBucketIndex(value);
+		ASSERT_LE(LatencyHistogram::getBucketLowerBound(index), value);
+		ASSERT_GE(LatencyHistogram::getBucketUpperBound(index), value);
+		/* relative error bounded by the sub-bucket resolution */
+		ASSERT_LE(LatencyHistogram::getBucketUpperBound(index) - LatencyHistogram::getBucketLowerBound(index), value / LatencyHistogram::subBuckets);
+	}
+
+	/* out of range values saturate in the last bucket */
+	ASSERT_EQ(LatencyHistogram::getBucketIndex(UINT64_MAX), LatencyHistogram::bucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, testPercentiles)
+{
+	LatencyHistogram histogram;
+	for (uint64_t i = 1; i <= 1000; i++)
+		histogram.record(i * 1000);
+
+	auto snapshot = histogram.getSnapshot();
+	ASSERT_EQ(snapshot.count, 1000);
+	ASSERT_EQ(snapshot.min, 1000);
+	ASSERT_EQ(snapshot.max, 1000000);
+	ASSERT_DOUBLE_EQ(snapshot.getMean(), 500500.0);
+
+	ASSERT_NEAR(snapshot.getPercentile(50.0), 500000, 500000 / LatencyHistogram::subBuckets);
+	ASSERT_NEAR(snapshot.getPercentile(99.0), 990000, 990000 / LatencyHistogram::subBuckets);
+	ASSERT_EQ(snapshot.getPercentile(100.0), 1000000);
+
+	histogram.reset();
+	snapshot = histogram.getSnapshot();
+	ASSERT_EQ(snapshot.count, 0);
+	ASSERT_EQ(snapshot.min, 0);
+	ASSERT_EQ(snapshot.getPercentile(50.0), 0);
+}
+
+TEST(LatencyHistogramTest, testConcurrentRecording)
+{
+	LatencyHistogram histogram;
+	std::vector<std::thread> threads;
+
+	for (uint64_t t = 0; t < 4; t++)
+		threads.emplace_back([&histogram, t]()
+							 { for (uint64_t i = 0; i < 10000; i++) histogram.record(t * 100 + i % 50); });
+
+	for (auto& thread : threads)
+		thread.join();
+
+	auto snapshot = histogram.getSnapshot();
+	ASSERT_EQ(snapshot.count, 40000);
+	ASSERT_EQ(snapshot.min, 0);
+	ASSERT_EQ(snapshot.max, 349);
+}
+
+TEST(LatencyHistogramTest, testProbeStatisticsDump)
+{
+	ProbeStatistics statistics;
+	const auto start = ProbeStatistics::Clock::now();
+	statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, true);
+	statistics.record(ProbeStatistics::Operation::READ_MEMORY, start, false);
+	statistics.addRetry(ProbeStatistics::Operation::WRITE_MEMORY);
+
+	auto summary = statistics.getSummary(ProbeStatistics::Operation::READ_MEMORY);
+	ASSERT_EQ(summary.latency.count, 2);
+	ASSERT_EQ(summary.failures, 1);
+	ASSERT_EQ(statistics.getSummary(ProbeStatistics::Operation::WRITE_MEMORY).retries, 1);
+
+	auto dump = statistics.dump();
+	ASSERT_NE(dump.find("readMemory,2,1,0,"), std::string::npos);
+	ASSERT_NE(dump.find("writeMemory,0,0,1,"), std::string::npos);
+
+	statistics.reset();
+	ASSERT_EQ(statistics.getSummary(ProbeStatistics::Operation::READ_MEMORY).latency.count, 0);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "ProbeDiscovery.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+using namespace std::chrono_literals;
+
+class ProbeDiscoveryTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("discovery", std::make_shared<spdlog::sinks::null_sink_mt>());
+		discovery = std::make_unique<ProbeDiscovery>(logger.get());
+		discovery->addSource("USB", [this]() -> std::optional<std::vector<std::string>>
+							 {
+								 calls++;
+								 std::lock_guard<std::mutex> lock(mtx);
+								 if (busy)
+									 return std::nullopt;
+								 return devices; });
+	}
+
+	void setDevices(const std::vector<std::string>& newDevices)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		devices = newDevices;
+	}
+
+	bool waitForEvent(ProbeDiscovery::Event& event, std::chrono::milliseconds timeout = 2000ms)
+	{
+		const auto end = std::chrono::steady_clock::now() + timeout;
+		while (std::chrono::steady_clock::now() < end)
+		{
+			if (discovery->popEvent(event))
+				return true;
+			std::this_thread::sleep_for(1ms);
+		}
+		return false;
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<ProbeDiscovery> discovery;
+	std::mutex mtx;
+	std::vector<std::string> devices{"A"};
+	bool busy = false;
+	std::atomic<uint32_t> calls = 0;
+};
+
+TEST_F(ProbeDiscoveryTest, testRescanOnRequest)
+{
+	/* polling is effectively off, every change below comes from a rescan request */
+	discovery->start(1h);
+
+	ProbeDiscovery::Event event;
+	ASSERT_TRUE(waitForEvent(event));
+	ASSERT_EQ(event.source, "USB");
+	ASSERT_EQ(event.devices, std::vector<std::string>({"A"}));
+	ASSERT_EQ(discovery->getDevices("USB"), std::vector<std::string>({"A"}));
+	ASSERT_TRUE(discovery->getDevices("other").empty());
+
+	/* an unchanged list produces no event */
+	uint64_t scans = discovery->getScanCount();
+	discovery->requestRescan();
+	while (discovery->getScanCount() == scans)
+		std::this_thread::sleep_for(1ms);
+	ASSERT_FALSE(discovery->popEvent(event));
+
+	setDevices({"A", "B"});
+	discovery->requestRescan();
+	ASSERT_TRUE(waitForEvent(event));
+	ASSERT_EQ(event.devices, std::vector<std::string>({"A", "B"}));
+
+	discovery->stop();
+	ASSERT_EQ(discovery->getDevices("USB"), std::vector<std::string>({"A", "B"}));
+}
+
+TEST_F(ProbeDiscoveryTest, testPollingAndBusySource)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		busy = true;
+	}
+	discovery->start(10ms);
+
+	/* a busy source keeps its cache and is retried */
+	while (calls < 2)
+		std::this_thread::sleep_for(1ms);
+
+	ProbeDiscovery::Event event;
+	ASSERT_FALSE(discovery->popEvent(event));
+	ASSERT_TRUE(discovery->getDevices("USB").empty());
+
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		busy = false;
+	}
+	ASSERT_TRUE(waitForEvent(event));
+	ASSERT_EQ(event.devices, std::vector<std::string>({"A"}));
+
+	/* picked up by polling alone */
+	setDevices({});
+	ASSERT_TRUE(waitForEvent(event));
+	ASSERT_TRUE(event.devices.empty());
+}
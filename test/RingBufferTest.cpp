@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <thread>
+#include <vector>
 
 #include "RingBuffer.hpp"
+#include "RingBufferLockFree.hpp"
 
 TEST(RingBufferTest, testpushpop)
 {
@@ -20,3 +23,80 @@ TEST(RingBufferTest, testpushpop)
 	ASSERT_EQ(ringBuffer.pop(), array2);
 	ASSERT_EQ(ringBuffer.pop(), array3);
 }
+
+TEST(RingBufferTest, testLockFreeFull)
+{
+	RingBufferLockFree<int, 3> ringBuffer;
+
+	ASSERT_TRUE(ringBuffer.empty());
+	ASSERT_TRUE(ringBuffer.push(1));
+	ASSERT_TRUE(ringBuffer.push(2));
+	ASSERT_TRUE(ringBuffer.push(3));
+	ASSERT_FALSE(ringBuffer.push(4));
+	ASSERT_EQ(ringBuffer.size(), 3);
+
+	ASSERT_EQ(ringBuffer.pop(), 1);
+	ASSERT_TRUE(ringBuffer.push(4));
+	ASSERT_EQ(ringBuffer.pop(), 2);
+	ASSERT_EQ(ringBuffer.pop(), 3);
+	ASSERT_EQ(ringBuffer.pop(), 4);
+	ASSERT_EQ(ringBuffer.pop(), std::nullopt);
+}
+
+TEST(RingBufferTest, testLockFreeProducerConsumer)
+{
+	static constexpr int items = 10000;
+	RingBufferLockFree<int, 16> ringBuffer;
+
+	std::thread producer([&]()
+						 {
+		for (int i = 0; i < items; i++)
+			while (!ringBuffer.push(i))
+				std::this_thread::yield(); });
+
+	for (int expected = 0; expected < items;)
+	{
+		auto item = ringBuffer.pop();
+		if (!item.has_value())
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(item.value(), expected++);
+	}
+
+	producer.join();
+	ASSERT_TRUE(ringBuffer.empty());
+}
+
+TEST(RingBufferTest, testLockFreeInPlace)
+{
+	RingBufferLockFree<std::vector<int>, 2> ringBuffer;
+
+	ASSERT_EQ(ringBuffer.front(), nullptr);
+
+	for (int i = 0; i < 2; i++)
+	{
+		auto slot = ringBuffer.getWriteSlot();
+		ASSERT_NE(slot, nullptr);
+		slot->assign(100, i);
+		ringBuffer.commitWrite();
+	}
+	ASSERT_EQ(ringBuffer.getWriteSlot(), nullptr);
+
+	auto item = ringBuffer.front();
+	ASSERT_NE(item, nullptr);
+	ASSERT_EQ(item->front(), 0);
+	ringBuffer.popFront();
+
+	auto slot = ringBuffer.getWriteSlot();
+	ASSERT_NE(slot, nullptr);
+	slot->assign(10, 2);
+	ringBuffer.commitWrite();
+
+	ASSERT_EQ(ringBuffer.front()->front(), 1);
+	ringBuffer.popFront();
+	ASSERT_EQ(ringBuffer.front()->size(), 10);
+	ringBuffer.popFront();
+	ASSERT_TRUE(ringBuffer.empty());
+}
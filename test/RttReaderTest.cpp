@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "RttReader.hpp"
+#include "SimulatedDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+/* the test plays the target side - it lays out the control block in the simulated RAM and writes the up-buffer */
+class RttReaderTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("rtt", std::make_shared<spdlog::sinks::null_sink_mt>());
+		probe = std::make_unique<SimulatedDebugProbe>(logger.get());
+		ASSERT_TRUE(probe->startAcqusition({}, sampleList, 100));
+
+		uint8_t header[RttReader::controlBlockHeaderSize]{};
+		std::memcpy(header, RttReader::controlBlockId, sizeof(RttReader::controlBlockId));
+		uint32_t counts[2]{1, 1};
+		std::memcpy(header + RttReader::controlBlockIdSize, counts, sizeof(counts));
+		write(controlBlock, header, sizeof(header));
+
+		uint32_t descriptor[6]{nameAddress, bufferAddress, bufferSize, 0, 0, 0};
+		write(controlBlock + RttReader::controlBlockHeaderSize, (uint8_t*)descriptor, sizeof(descriptor));
+		write(nameAddress, (uint8_t*)"Terminal", 9);
+	}
+
+	void write(uint32_t address, const uint8_t* data, uint32_t size)
+	{
+		ASSERT_TRUE(probe->writeMemory(address, const_cast<uint8_t*>(data), size));
+	}
+
+	void setOffsets(uint32_t writeOffset, uint32_t readOffset)
+	{
+		uint32_t offsets[2]{writeOffset, readOffset};
+		write(controlBlock + RttReader::controlBlockHeaderSize + RttReader::writeOffsetOffset, (uint8_t*)offsets, sizeof(offsets));
+	}
+
+	uint32_t getReadOffset()
+	{
+		uint32_t value = 0;
+		probe->readMemory(controlBlock + RttReader::controlBlockHeaderSize + RttReader::readOffsetOffset, (uint8_t*)&value, 4);
+		return value;
+	}
+
+	static constexpr uint32_t controlBlock = 0x20001a40;
+	static constexpr uint32_t nameAddress = 0x20000100;
+	static constexpr uint32_t bufferAddress = 0x20002000;
+	static constexpr uint32_t bufferSize = 64;
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<SimulatedDebugProbe> probe;
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{};
+};
+
+TEST_F(RttReaderTest, testFindAndRead)
+{
+	RttReader reader(probe.get(), logger.get());
+	ASSERT_FALSE(reader.attach(controlBlock + 4));
+	ASSERT_TRUE(reader.find(0x20000000, 0x4000));
+	ASSERT_EQ(reader.getControlBlockAddress(), controlBlock);
+	ASSERT_EQ(reader.getUpBuffers().size(), 1);
+	ASSERT_EQ(reader.getUpBuffers()[0].name, "Terminal");
+	ASSERT_EQ(reader.getUpBuffers()[0].size, bufferSize);
+
+	std::vector<uint8_t> data;
+	ASSERT_EQ(reader.read(0, data), 0);
+
+	std::vector<uint8_t> payload{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	write(bufferAddress, payload.data(), payload.size());
+	setOffsets(10, 0);
+
+	/* offsets, one block and the read offset write */
+	uint64_t transactions = probe->getTransactionCount();
+	ASSERT_EQ(reader.read(0, data), 10);
+	ASSERT_EQ(probe->getTransactionCount() - transactions, 3);
+	ASSERT_EQ(data, payload);
+	ASSERT_EQ(getReadOffset(), 10);
+	ASSERT_EQ(reader.getBytesRead(), 10);
+}
+
+TEST_F(RttReaderTest, testWrappedBuffer)
+{
+	RttReader reader(probe.get(), logger.get());
+	ASSERT_TRUE(reader.attach(controlBlock));
+
+	std::vector<uint8_t> tail{0xa0, 0xa1, 0xa2, 0xa3};
+	std::vector<uint8_t> head{0xb0, 0xb1, 0xb2};
+	write(bufferAddress + bufferSize - tail.size(), tail.data(), tail.size());
+	write(bufferAddress, head.data(), head.size());
+	setOffsets(head.size(), bufferSize - tail.size());
+
+	std::vector<uint8_t> data;
+	ASSERT_EQ(reader.read(0, data), 7);
+	ASSERT_EQ(data, std::vector<uint8_t>({0xa0, 0xa1, 0xa2, 0xa3, 0xb0, 0xb1, 0xb2}));
+	ASSERT_EQ(getReadOffset(), head.size());
+
+	/* corrupted offsets are rejected and nothing is freed */
+	setOffsets(bufferSize + 1, 3);
+	ASSERT_EQ(reader.read(0, data), -1);
+	ASSERT_EQ(getReadOffset(), 3);
+	ASSERT_EQ(data.size(), 7);
+}
+
+TEST_F(RttReaderTest, testRecordDecoder)
+{
+	auto makeRecord = [](uint8_t channel, uint32_t timestamp, uint32_t value)
+	{
+		std::vector<uint8_t> raw(RttRecordDecoder::recordSize);
+		raw[0] = channel;
+		std::memcpy(raw.data() + 1, &timestamp, 4);
+		std::memcpy(raw.data() + 5, &value, 4);
+		return raw;
+	};
+
+	std::vector<uint8_t> stream;
+	for (auto& record : {makeRecord(0, 0xfffffff0, 1), makeRecord(3, 0x10, 2), makeRecord(31, 0x20, 3)})
+		stream.insert(stream.end(), record.begin(), record.end());
+
+	RttRecordDecoder decoder;
+	std::vector<RttRecordDecoder::Record> records;
+
+	/* the second record is split between two reads */
+	ASSERT_EQ(decoder.decode(std::span(stream).subspan(0, 12), records), 1);
+	ASSERT_EQ(decoder.decode(std::span(stream).subspan(12), records), 2);
+	ASSERT_EQ(records.size(), 3);
+
+	ASSERT_EQ(records[0].channel, 0);
+	ASSERT_EQ(records[0].timestamp, 0xfffffff0);
+	ASSERT_EQ(records[0].value, 1);
+	ASSERT_EQ(records[1].channel, 3);
+	ASSERT_EQ(records[1].timestamp, 0x100000010);
+	ASSERT_EQ(records[2].channel, 31);
+	ASSERT_EQ(records[2].timestamp, 0x100000020);
+	ASSERT_EQ(records[2].value, 3);
+}
+
+TEST_F(RttReaderTest, testRecordWrappedAtUnalignedOffset)
+{
+	RttReader reader(probe.get(), logger.get());
+	ASSERT_TRUE(reader.attach(controlBlock));
+
+	std::vector<uint8_t> raw(RttRecordDecoder::recordSize);
+	raw[0] = 5;
+	const uint32_t timestamp = 0x11223344;
+	const uint32_t value = 0xa5b6c7d8;
+	std::memcpy(raw.data() + 1, &timestamp, 4);
+	std::memcpy(raw.data() + 5, &value, 4);
+
+	/* the record starts at an odd offset and wraps after five bytes, the first drain sees a word sized unaligned chunk */
+	const uint32_t readOffset = bufferSize - 5;
+	write(bufferAddress + readOffset, raw.data(), 5);
+	write(bufferAddress, raw.data() + 5, 4);
+
+	RttRecordDecoder decoder;
+	std::vector<RttRecordDecoder::Record> records;
+	std::vector<uint8_t> data;
+
+	setOffsets(readOffset + 4, readOffset);
+	ASSERT_EQ(reader.read(0, data), 4);
+	ASSERT_EQ(decoder.decode(data, records), 0);
+
+	data.clear();
+	setOffsets(4, readOffset + 4);
+	ASSERT_EQ(reader.read(0, data), 5);
+	ASSERT_EQ(getReadOffset(), 4);
+	ASSERT_EQ(decoder.decode(data, records), 1);
+
+	ASSERT_EQ(records.size(), 1);
+	ASSERT_EQ(records[0].channel, 5);
+	ASSERT_EQ(records[0].timestamp, timestamp);
+	ASSERT_EQ(records[0].value, value);
+}
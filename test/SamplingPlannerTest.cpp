@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "SamplingPlanner.hpp"
+
+TEST(SamplingPlannerTest, testSwdTime)
+{
+	SamplingPlanner planner{};
+	planner.setProbe(0, 1000);
+
+	/* TAR write + one data transfer of 46 bits each at 1MHz */
+	ASSERT_NEAR(planner.getSwdTime(0x20000000, 4), 92e-6, 10e-12);
+	/* unaligned halfword crossing a word boundary needs two data transfers */
+	ASSERT_NEAR(planner.getSwdTime(0x20000003, 2), 138e-6, 10e-12);
+	ASSERT_DOUBLE_EQ(planner.getSwdTime(0x20000000, 0), 0.0);
+}
+
+TEST(SamplingPlannerTest, testCoalesce)
+{
+	SamplingPlanner planner{};
+	planner.setProbe(0, 4000);
+
+	std::vector<SamplingPlanner::Entry> entries{{0x20000008, 4}, {0x20000000, 4}, {0x20000004, 2}, {0x20010000, 4}};
+	auto blocks = planner.coalesce(entries);
+
+	ASSERT_EQ(blocks.size(), 2);
+	ASSERT_EQ(blocks[0].address, 0x20000000);
+	ASSERT_EQ(blocks[0].size, 12);
+	ASSERT_EQ(blocks[0].entries, 3);
+	ASSERT_EQ(blocks[1].address, 0x20010000);
+	ASSERT_EQ(blocks[1].entries, 1);
+}
+
+TEST(SamplingPlannerTest, testEstimate)
+{
+	SamplingPlanner planner{};
+	planner.setProbe(0, 4000);
+
+	std::vector<SamplingPlanner::Entry> entries{{0x20000000, 4}, {0x20000004, 4}};
+	auto estimate = planner.estimate(entries, 1000000);
+
+	ASSERT_GT(estimate.normalMaxFrequencyHz, 0.0);
+	ASSERT_GT(estimate.coalescedMaxFrequencyHz, estimate.normalMaxFrequencyHz);
+	/* STLink HSS does the same reads as the NORMAL mode, only in the probe thread */
+	ASSERT_DOUBLE_EQ(estimate.hssMaxFrequencyHz, estimate.normalMaxFrequencyHz);
+	ASSERT_FALSE(estimate.suggestions.empty());
+
+	/* slower rate classes increase the achievable base rate */
+	entries[1].divider = 10;
+	ASSERT_GT(planner.estimate(entries, 1000000).normalMaxFrequencyHz, estimate.normalMaxFrequencyHz);
+
+	planner.setProbe(1, 4000);
+	ASSERT_GT(planner.estimate(entries, 1000).hssMaxFrequencyHz, 0.0);
+}
+
+TEST(SamplingPlannerTest, testCalibration)
+{
+	SamplingPlanner planner{};
+	planner.setProbe(0, 4000);
+	double defaultOverhead = planner.getTransactionOverhead();
+
+	for (size_t i = 0; i < SamplingPlanner::minCalibrationSamples - 1; i++)
+		planner.addMeasurement(4, 1e-3);
+
+	ASSERT_FALSE(planner.isCalibrated());
+	ASSERT_DOUBLE_EQ(planner.getTransactionOverhead(), defaultOverhead);
+
+	planner.addMeasurement(4, 1e-3);
+	ASSERT_TRUE(planner.isCalibrated());
+	ASSERT_NEAR(planner.getTransactionOverhead(), 1e-3 - planner.getSwdTime(0, 4), 10e-9);
+
+	/* calibration is probe specific */
+	planner.setProbe(1, 4000);
+	ASSERT_FALSE(planner.isCalibrated());
+}
+
+TEST(SamplingPlannerTest, testBatchCalibration)
+{
+	SamplingPlanner planner{};
+	planner.setProbe(0, 4000);
+
+	std::vector<std::pair<uint32_t, uint8_t>> reads(SamplingPlanner::minCalibrationSamples, {0x20000000, 4});
+	const double latency = reads.size() * 1e-3;
+
+	/* a single batch counts each of its reads */
+	planner.addMeasurement(reads, latency);
+	ASSERT_TRUE(planner.isCalibrated());
+	ASSERT_NEAR(planner.getTransactionOverhead(), 1e-3 - planner.getSwdTime(0, 4), 10e-9);
+}
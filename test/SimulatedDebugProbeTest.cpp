@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <thread>
+
+#include "SimulatedDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+class SimulatedDebugProbeTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("simulated", std::make_shared<spdlog::sinks::null_sink_mt>());
+		probe = std::make_unique<SimulatedDebugProbe>(logger.get());
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<SimulatedDebugProbe> probe;
+};
+
+TEST_F(SimulatedDebugProbeTest, testReadWrite)
+{
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{};
+	ASSERT_TRUE(probe->startAcqusition({}, sampleList, 100));
+
+	uint32_t written = 0x12345678;
+	ASSERT_TRUE(probe->writeMemory(0x20000ffe, (uint8_t*)&written, sizeof(written)));
+
+	uint32_t value = 0xffffffff;
+	ASSERT_TRUE(probe->readMemory(0x20000ffe, (uint8_t*)&value, 4));
+	ASSERT_EQ(value, 0x12345678);
+
+	/* single word reads are zero extended */
+	value = 0xffffffff;
+	ASSERT_TRUE(probe->readMemory(0x20001000, (uint8_t*)&value, 2));
+	ASSERT_EQ(value, 0x1234);
+
+	ASSERT_TRUE(probe->readMemory(0x30000000, (uint8_t*)&value, 4));
+	ASSERT_EQ(value, 0);
+
+	probe->stopAcqusition();
+	ASSERT_FALSE(probe->readMemory(0x20000ffe, (uint8_t*)&value, 4));
+}
+
+TEST_F(SimulatedDebugProbeTest, testHssGenerators)
+{
+	SimulatedDebugProbe::Signal counter{};
+	counter.address = 0x20000000;
+	counter.size = 2;
+	counter.generator = SimulatedDebugProbe::Generator::COUNTER;
+	counter.frequencyHz = 100.0;
+
+	SimulatedDebugProbe::Signal sine{};
+	sine.address = 0x20000004;
+	sine.size = 4;
+	sine.generator = SimulatedDebugProbe::Generator::SINE;
+	sine.encoding = SimulatedDebugProbe::Encoding::FLOAT;
+	sine.amplitude = 2.0;
+	sine.frequencyHz = 10.0;
+
+	probe->setSignals({counter, sine});
+
+	IDebugProbe::DebugProbeSettings settings{};
+	settings.mode = IDebugProbe::Mode::HSS;
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{{0x20000000, 2}, {0x20000004, 4}, {0x20000010, 4}};
+	ASSERT_TRUE(probe->startAcqusition(settings, sampleList, 1000));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	std::vector<IDebugProbe::Frame> frames(32);
+	ASSERT_EQ(probe->readEntries(frames), frames.size());
+
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		ASSERT_NEAR(frames[i].timestamp, i * 0.001, 1e-12);
+		ASSERT_EQ(frames[i].values.size(), sampleList.size());
+		ASSERT_EQ(frames[i].values[0], i / 10);
+
+		float sineValue = 0.0f;
+		std::memcpy(&sineValue, &frames[i].values[1], sizeof(float));
+		ASSERT_NEAR(sineValue, 2.0 * std::sin(2.0 * std::numbers::pi * 10.0 * i * 0.001), 1e-5);
+	}
+
+	/* the next read continues where the previous one ended */
+	ASSERT_GT(probe->readEntries(frames), 0);
+	ASSERT_NEAR(frames[0].timestamp, 0.032, 1e-12);
+}
+
+TEST_F(SimulatedDebugProbeTest, testLatencyAndErrors)
+{
+	SimulatedDebugProbe::Settings settings{};
+	settings.latencyUs = 2000;
+	probe->setSettings(settings);
+
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{};
+	ASSERT_TRUE(probe->startAcqusition({}, sampleList, 100));
+
+	uint32_t value = 0;
+	auto start = std::chrono::steady_clock::now();
+	ASSERT_TRUE(probe->readMemory(0x20000000, (uint8_t*)&value, 4));
+	ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(2000));
+
+	settings.latencyUs = 0;
+	settings.errorRate = 1.0;
+	probe->setSettings(settings);
+
+	ASSERT_FALSE(probe->readMemory(0x20000000, (uint8_t*)&value, 4));
+	ASSERT_FALSE(probe->writeMemory(0x20000000, (uint8_t*)&value, 4));
+	ASSERT_EQ(probe->getInjectedErrorCount(), 2);
+	ASSERT_EQ(probe->getTransactionCount(), 3);
+	ASSERT_FALSE(probe->getLastErrorMsg().empty());
+}
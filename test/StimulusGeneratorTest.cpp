@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "StimulusGenerator.hpp"
+
+TEST(StimulusGeneratorTest, testStep)
+{
+	StimulusGenerator::Settings settings{};
+	settings.type = StimulusGenerator::Type::STEP;
+	settings.offset = 1.0;
+	settings.amplitude = 2.0;
+	settings.time = 0.5;
+	StimulusGenerator generator(settings);
+
+	ASSERT_DOUBLE_EQ(generator.getValue(0.0), 1.0);
+	ASSERT_DOUBLE_EQ(generator.getValue(0.49), 1.0);
+	ASSERT_DOUBLE_EQ(generator.getValue(0.5), 3.0);
+}
+
+TEST(StimulusGeneratorTest, testRamp)
+{
+	StimulusGenerator::Settings settings{};
+	settings.type = StimulusGenerator::Type::RAMP;
+	settings.offset = 1.0;
+	settings.amplitude = 2.0;
+	settings.time = 0.5;
+	StimulusGenerator generator(settings);
+
+	ASSERT_DOUBLE_EQ(generator.getValue(0.0), 1.0);
+	ASSERT_NEAR(generator.getValue(0.25), 2.0, 10e-9);
+	ASSERT_NEAR(generator.getValue(0.75), 2.0, 10e-9);
+}
+
+TEST(StimulusGeneratorTest, testSine)
+{
+	StimulusGenerator::Settings settings{};
+	settings.type = StimulusGenerator::Type::SINE;
+	settings.offset = 1.0;
+	settings.amplitude = 2.0;
+	settings.frequencyHz = 1.0;
+	StimulusGenerator generator(settings);
+
+	ASSERT_NEAR(generator.getValue(0.0), 1.0, 10e-9);
+	ASSERT_NEAR(generator.getValue(0.25), 3.0, 10e-9);
+	ASSERT_NEAR(generator.getValue(0.75), -1.0, 10e-9);
+}
+
+TEST(StimulusGeneratorTest, testChirp)
+{
+	StimulusGenerator::Settings settings{};
+	settings.type = StimulusGenerator::Type::CHIRP;
+	settings.offset = 1.0;
+	settings.amplitude = 2.0;
+	settings.time = 1.0;
+	settings.frequencyHz = 1.0;
+	settings.endFrequencyHz = 3.0;
+	StimulusGenerator generator(settings);
+
+	/* phase at t = 0.5 is 2pi * (0.5 + 2 * 0.25 / 2) = 1.5pi */
+	ASSERT_NEAR(generator.getValue(0.5), -1.0, 10e-9);
+	/* waveform restarts after the period */
+	ASSERT_NEAR(generator.getValue(1.25), generator.getValue(0.25), 10e-9);
+}
+
+TEST(StimulusGeneratorTest, testProfile)
+{
+	const char* path = "stimulus_profile_test.csv";
+	{
+		std::ofstream file(path);
+		file << "time,value\n0.0,0.0\n1.0,10.0\n2.0;-10.0\n";
+	}
+
+	StimulusGenerator::Settings settings{};
+	settings.type = StimulusGenerator::Type::PROFILE;
+	StimulusGenerator generator(settings);
+	ASSERT_TRUE(generator.loadProfile(path));
+	std::remove(path);
+
+	ASSERT_DOUBLE_EQ(generator.getValue(-1.0), 0.0);
+	ASSERT_DOUBLE_EQ(generator.getValue(0.5), 5.0);
+	ASSERT_DOUBLE_EQ(generator.getValue(1.5), 0.0);
+	ASSERT_DOUBLE_EQ(generator.getValue(3.0), -10.0);
+	ASSERT_FALSE(generator.loadProfile("nonexistent_profile.csv"));
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "ThreadPriority.hpp"
+
+TEST(ThreadPriorityTest, testDefaultSettings)
+{
+	std::string errorMsg;
+	bool result = false;
+
+	std::thread thread([&]()
+					   { result = ThreadPriority::apply(ThreadPriority::Settings{}, errorMsg); });
+	thread.join();
+
+	ASSERT_TRUE(result);
+	ASSERT_TRUE(errorMsg.empty());
+}
+
+TEST(ThreadPriorityTest, testInvalidCore)
+{
+	ThreadPriority::Settings settings{};
+	settings.cpuCore = ThreadPriority::getCoreCount();
+
+	std::string errorMsg;
+	bool result = true;
+
+	std::thread thread([&]()
+					   { result = ThreadPriority::apply(settings, errorMsg); });
+	thread.join();
+
+	ASSERT_FALSE(result);
+	ASSERT_FALSE(errorMsg.empty());
+}
+
+TEST(ThreadPriorityTest, testRealTimeFallback)
+{
+	ThreadPriority::Settings settings{};
+	settings.policy = ThreadPriority::Policy::FIFO;
+	settings.priority = 1000;
+	settings.cpuCore = 0;
+
+	std::string errorMsg;
+	bool result = false;
+
+	/* without privileges the call fails but has to report why */
+	std::thread thread([&]()
+					   { result = ThreadPriority::apply(settings, errorMsg); });
+	thread.join();
+
+	ASSERT_EQ(result, errorMsg.empty());
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <iostream>
+#include <unordered_map>
 
 #include "Variable.hpp"
 
@@ -110,3 +111,78 @@ TEST(VariableTest, testUnsignedFracUnsignedVarNegative)
 
 	ASSERT_NEAR(value, 1.0, 10e-3);
 }
+
+TEST(VariableTest, testPointerOffsetsString)
+{
+	Variable var{"test"};
+
+	ASSERT_TRUE(var.setPointerOffsetsFromString("0x10, 8 ,-4"));
+	ASSERT_EQ(var.getPointerOffsets(), (std::vector<int32_t>{16, 8, -4}));
+	ASSERT_EQ(var.getPointerOffsetsString(), "16,8,-4");
+
+	ASSERT_FALSE(var.setPointerOffsetsFromString("0x10, abc"));
+	ASSERT_EQ(var.getPointerOffsets().size(), 3);
+
+	ASSERT_TRUE(var.setPointerOffsetsFromString(""));
+	ASSERT_FALSE(var.isPointerChain());
+}
+
+TEST(VariableTest, testPointerChainResolve)
+{
+	std::unordered_map<uint32_t, uint32_t> memory{{0x20000000, 0x20001000}, {0x20001010, 0x20002000}};
+	auto readPointer = [&](uint32_t address, uint32_t& pointer)
+	{
+		if (!memory.contains(address))
+			return false;
+		pointer = memory.at(address);
+		return true;
+	};
+
+	Variable var{"test"};
+	var.setAddress(0x20000000);
+	ASSERT_EQ(var.getSampleAddress(), 0x20000000);
+
+	var.setPointerOffsets({0x10, 0x8});
+	ASSERT_FALSE(var.isAddressResolved());
+	ASSERT_TRUE(var.resolveAddress(readPointer));
+	ASSERT_TRUE(var.isAddressResolved());
+	ASSERT_EQ(var.getSampleAddress(), 0x20002008);
+	ASSERT_EQ(var.getAddress(), 0x20000000);
+
+	/* null pointer in the chain */
+	memory[0x20001010] = 0;
+	ASSERT_FALSE(var.resolveAddress(readPointer));
+	ASSERT_FALSE(var.isAddressResolved());
+}
+
+TEST(VariableTest, testSortByBaseDependency)
+{
+	Variable base{"base"};
+	Variable scaled{"scaled"};
+	Variable scaledTwice{"scaledTwice"};
+	Variable plain{"plain"};
+
+	scaled.setFractional({.fractionalBits = 15, .base = 1.0, .baseVariable = &base});
+	scaledTwice.setFractional({.fractionalBits = 15, .base = 1.0, .baseVariable = &scaled});
+
+	std::vector<Variable*> cyclic;
+	auto sorted = Variable::sortByBaseDependency({&scaledTwice, &plain, &scaled}, cyclic);
+
+	ASSERT_TRUE(cyclic.empty());
+	ASSERT_EQ(sorted, std::vector<Variable*>({&base, &scaled, &scaledTwice, &plain}));
+}
+
+TEST(VariableTest, testSortByBaseDependencyCycle)
+{
+	Variable first{"first"};
+	Variable second{"second"};
+
+	first.setFractional({.fractionalBits = 15, .base = 1.0, .baseVariable = &second});
+	second.setFractional({.fractionalBits = 15, .base = 1.0, .baseVariable = &first});
+
+	std::vector<Variable*> cyclic;
+	auto sorted = Variable::sortByBaseDependency({&first}, cyclic);
+
+	ASSERT_EQ(sorted.size(), 2);
+	ASSERT_EQ(cyclic, std::vector<Variable*>({&first}));
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "VariableTrigger.hpp"
+
+TEST(VariableTriggerTest, testDisabled)
+{
+	VariableTrigger trigger{};
+
+	ASSERT_FALSE(trigger.isEnabled());
+	ASSERT_FALSE(trigger.check(100.0, 100));
+}
+
+TEST(VariableTriggerTest, testLevel)
+{
+	VariableTrigger::Settings settings{};
+	settings.type = VariableTrigger::Type::LEVEL;
+	settings.level = 1.5;
+	VariableTrigger trigger(settings);
+
+	ASSERT_FALSE(trigger.check(1.0, 0));
+	ASSERT_TRUE(trigger.check(2.0, 0));
+	ASSERT_TRUE(trigger.check(3.0, 0));
+}
+
+TEST(VariableTriggerTest, testRisingEdge)
+{
+	VariableTrigger::Settings settings{};
+	settings.type = VariableTrigger::Type::RISING_EDGE;
+	settings.level = 1.5;
+	VariableTrigger trigger(settings);
+
+	/* no edge on the first sample even if above the level */
+	ASSERT_FALSE(trigger.check(2.0, 0));
+	ASSERT_FALSE(trigger.check(1.0, 0));
+	ASSERT_TRUE(trigger.check(2.0, 0));
+	ASSERT_FALSE(trigger.check(3.0, 0));
+	ASSERT_FALSE(trigger.check(0.0, 0));
+}
+
+TEST(VariableTriggerTest, testFallingEdge)
+{
+	VariableTrigger::Settings settings{};
+	settings.type = VariableTrigger::Type::FALLING_EDGE;
+	settings.level = 1.5;
+	VariableTrigger trigger(settings);
+
+	ASSERT_FALSE(trigger.check(2.0, 0));
+	ASSERT_TRUE(trigger.check(1.0, 0));
+	ASSERT_FALSE(trigger.check(0.0, 0));
+	ASSERT_FALSE(trigger.check(2.0, 0));
+}
+
+TEST(VariableTriggerTest, testBitmask)
+{
+	VariableTrigger::Settings settings{};
+	settings.type = VariableTrigger::Type::BITMASK;
+	settings.mask = 0x0000000c;
+	settings.value = 0x00000008;
+	VariableTrigger trigger(settings);
+
+	ASSERT_FALSE(trigger.check(0.0, 0x00000004));
+	ASSERT_TRUE(trigger.check(0.0, 0x000000f8));
+	ASSERT_FALSE(trigger.check(0.0, 0x0000000c));
+}
+
+TEST(VariableTriggerTest, testChange)
+{
+	VariableTrigger::Settings settings{};
+	settings.type = VariableTrigger::Type::CHANGE;
+	VariableTrigger trigger(settings);
+
+	ASSERT_FALSE(trigger.check(0.0, 5));
+	ASSERT_FALSE(trigger.check(0.0, 5));
+	ASSERT_TRUE(trigger.check(0.0, 6));
+
+	trigger.reset();
+	ASSERT_FALSE(trigger.check(0.0, 7));
+}
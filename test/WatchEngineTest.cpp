@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "WatchEngine.hpp"
+
+static int32_t resolve(const std::string& name)
+{
+	return name == "var" ? 0 : -1;
+}
+
+TEST(WatchEngineTest, testGreaterWithHysteresis)
+{
+	WatchEngine engine;
+	WatchEngine::Watch watch{};
+	watch.variableName = "var";
+	watch.condition = WatchEngine::Condition::GREATER;
+	watch.threshold = 10.0;
+	watch.hysteresis = 2.0;
+	engine.setWatches({watch});
+	ASSERT_EQ(engine.compile(resolve), 1);
+
+	std::vector<double> samples{5.0, 11.0, 9.0, 12.0, 7.0, 11.0};
+	for (size_t i = 0; i < samples.size(); i++)
+		engine.process(static_cast<double>(i), {samples[i]});
+
+	/* 9.0 does not release the watch, 7.0 does */
+	auto events = engine.getEvents();
+	ASSERT_EQ(events.size(), 2);
+	ASSERT_DOUBLE_EQ(events[0].timestamp, 1.0);
+	ASSERT_DOUBLE_EQ(events[1].timestamp, 5.0);
+	ASSERT_EQ(events[0].context, std::vector<double>({5.0, 11.0}));
+}
+
+TEST(WatchEngineTest, testDebounce)
+{
+	WatchEngine engine;
+	WatchEngine::Watch watch{};
+	watch.variableName = "var";
+	watch.condition = WatchEngine::Condition::EQUAL;
+	watch.threshold = 3.0;
+	watch.debounceSamples = 3;
+	engine.setWatches({watch});
+	engine.compile(resolve);
+
+	std::vector<double> samples{3.0, 3.0, 0.0, 3.0, 3.0, 3.0, 3.0};
+	for (size_t i = 0; i < samples.size(); i++)
+		engine.process(static_cast<double>(i), {samples[i]});
+
+	auto events = engine.getEvents();
+	ASSERT_EQ(events.size(), 1);
+	ASSERT_DOUBLE_EQ(events[0].timestamp, 5.0);
+}
+
+TEST(WatchEngineTest, testBitmaskAndStop)
+{
+	WatchEngine engine;
+	WatchEngine::Watch watch{};
+	watch.variableName = "var";
+	watch.condition = WatchEngine::Condition::BITMASK;
+	watch.threshold = 0x4;
+	watch.mask = 0x6;
+	watch.stopAcquisition = true;
+	engine.setWatches({watch});
+	engine.compile(resolve);
+
+	ASSERT_FALSE(engine.process(0.0, {0x2}));
+	ASSERT_TRUE(engine.process(1.0, {0xd}));
+	ASSERT_EQ(engine.getEventCount(), 1);
+}
+
+TEST(WatchEngineTest, testUnresolvedAndDisabled)
+{
+	WatchEngine engine;
+	WatchEngine::Watch unresolved{};
+	unresolved.variableName = "missing";
+	WatchEngine::Watch disabled{};
+	disabled.variableName = "var";
+	disabled.condition = WatchEngine::Condition::GREATER;
+	disabled.enabled = false;
+	engine.setWatches({unresolved, disabled});
+
+	ASSERT_EQ(engine.compile(resolve), 0);
+	ASSERT_TRUE(engine.isEmpty());
+}
+
+TEST(WatchEngineTest, testBoundedLog)
+{
+	WatchEngine engine;
+	WatchEngine::Watch watch{};
+	watch.variableName = "var";
+	watch.condition = WatchEngine::Condition::NOT_EQUAL;
+	engine.setWatches({watch});
+	engine.compile(resolve);
+
+	for (size_t i = 0; i < 2 * WatchEngine::maxEvents; i++)
+	{
+		engine.process(static_cast<double>(i), {1.0});
+		engine.process(static_cast<double>(i), {0.0});
+	}
+
+	ASSERT_EQ(engine.getEvents().size(), WatchEngine::maxEvents);
+	ASSERT_EQ(engine.getEventCount(), 2 * WatchEngine::maxEvents);
+	ASSERT_EQ(engine.getEvents().back().context.size(), WatchEngine::contextSamples);
+
+	engine.clearEvents();
+	ASSERT_TRUE(engine.getEvents().empty());
+}